@@ -0,0 +1,147 @@
+//
+//  BatchRenderer.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "BatchRenderer.hpp"
+#include "VertexBufferLayout.hpp"
+
+//Corners of a unit quad centered on 0,0 with the texture coordinates that go with them
+//Same winding as the quad in TestTexture2D
+static const glm::vec4 s_QuadPositions[4] = {
+    { -0.5f, -0.5f, 0.0f, 1.0f },
+    {  0.5f, -0.5f, 0.0f, 1.0f },
+    {  0.5f,  0.5f, 0.0f, 1.0f },
+    { -0.5f,  0.5f, 0.0f, 1.0f }
+};
+
+static const glm::vec2 s_QuadTexCoords[4] = {
+    { 0.0f, 0.0f },
+    { 1.0f, 0.0f },
+    { 1.0f, 1.0f },
+    { 0.0f, 1.0f }
+};
+
+BatchRenderer::BatchRenderer(unsigned int maxQuads)
+    : m_MaxQuads(maxQuads), m_StreamGrowCount(0), m_Shader(nullptr)
+{
+    //Each region starts out holding one full batch per frame, frames that flush more often than that grow it
+    m_VertexStream = std::make_unique<StreamingBuffer>(GL_ARRAY_BUFFER, maxQuads * 4 * (unsigned int)sizeof(BatchVertex));
+    CreateVertexArray();
+
+    //Every quad uses the same 6 indices offset by 4 vertices
+    //Only needs to be built once since the pattern never changes
+    std::vector<unsigned int> indices(maxQuads * 6);
+    for (unsigned int i = 0, offset = 0; i < indices.size(); i += 6, offset += 4)
+    {
+        indices[i + 0] = offset + 0;
+        indices[i + 1] = offset + 1;
+        indices[i + 2] = offset + 2;
+
+        indices[i + 3] = offset + 2;
+        indices[i + 4] = offset + 3;
+        indices[i + 5] = offset + 0;
+    }
+    m_IndexBuffer = std::make_unique<IndexBuffer>(indices.data(), (unsigned int)indices.size());
+
+    m_Vertices.reserve(maxQuads * 4);
+}
+
+BatchRenderer::~BatchRenderer()
+{
+}
+
+void BatchRenderer::CreateVertexArray()
+{
+    m_VAO = std::make_unique<VertexArray>();
+
+    VertexBufferLayout layout;
+    //Position
+    layout.Push<float>(3);
+    //Texture coordinates
+    layout.Push<float>(2);
+    //TextureArray layer
+    layout.Push<float>(1);
+    m_VAO->AddBuffer(*m_VertexStream, layout);
+    m_StreamGrowCount = m_VertexStream->GetGrowCount();
+}
+
+void BatchRenderer::BeginBatch(const Shader& shader)
+{
+    m_Shader = &shader;
+    m_Vertices.clear();
+}
+
+void BatchRenderer::SubmitQuad(const glm::mat4& transform, const glm::vec2& size)
+{
+    SubmitQuad(transform, size, glm::vec2(0.0f), glm::vec2(1.0f));
+}
+
+void BatchRenderer::SubmitQuad(const glm::vec3& position, const glm::vec2& size)
+{
+    SubmitQuad(position, size, glm::vec2(0.0f), glm::vec2(1.0f));
+}
+
+void BatchRenderer::SubmitQuad(const glm::mat4& transform, const glm::vec2& size, const glm::vec2& uvMin, const glm::vec2& uvMax, unsigned int layer)
+{
+    //Out of room, draw what we have and start over
+    if (m_Vertices.size() >= m_MaxQuads * 4)
+        Flush();
+
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        glm::vec4 corner(s_QuadPositions[i].x * size.x, s_QuadPositions[i].y * size.y, 0.0f, 1.0f);
+        m_Vertices.push_back({ glm::vec3(transform * corner), uvMin + (uvMax - uvMin) * s_QuadTexCoords[i], (float)layer });
+    }
+    m_Stats.QuadCount++;
+}
+
+void BatchRenderer::SubmitQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec2& uvMin, const glm::vec2& uvMax, unsigned int layer)
+{
+    //Translation only, so skip the matrix multiply
+    if (m_Vertices.size() >= m_MaxQuads * 4)
+        Flush();
+
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        glm::vec3 corner(position.x + s_QuadPositions[i].x * size.x, position.y + s_QuadPositions[i].y * size.y, position.z);
+        m_Vertices.push_back({ corner, uvMin + (uvMax - uvMin) * s_QuadTexCoords[i], (float)layer });
+    }
+    m_Stats.QuadCount++;
+}
+
+void BatchRenderer::EndBatch()
+{
+    Flush();
+    m_Shader = nullptr;
+}
+
+void BatchRenderer::Flush()
+{
+    if (m_Vertices.empty())
+        return;
+
+    //Need BeginBatch first so we know which shader to draw with
+    ASSERT(m_Shader);
+
+    unsigned int stride = (unsigned int)sizeof(BatchVertex);
+    unsigned int offset = m_VertexStream->Write(m_Vertices.data(), (unsigned int)m_Vertices.size() * stride, stride);
+    //Stream grew into a new buffer, the vertex array still points at the old one
+    if (m_VertexStream->GetGrowCount() != m_StreamGrowCount)
+        CreateVertexArray();
+    //4 vertices and 6 indices per quad
+    unsigned int indexCount = (unsigned int)(m_Vertices.size() / 4 * 6);
+    //Shared index buffer always starts at vertex 0, base vertex shifts it to where this batch landed in the stream
+    m_Renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader, indexCount, (int)(offset / stride));
+    m_Stats.DrawCalls++;
+
+    m_Vertices.clear();
+}
+
+void BatchRenderer::BeginFrame()
+{
+    m_Stats = BatchStats();
+    m_VertexStream->NextFrame();
+}
@@ -0,0 +1,89 @@
+//
+//  BatchRenderer.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef BatchRenderer_hpp
+#define BatchRenderer_hpp
+
+#include <memory>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Renderer.h"
+#include "StreamingBuffer.hpp"
+
+//Layout of a single vertex inside the batch
+//Positions are already transformed into world space on the CPU, so the shader only needs the view projection
+struct BatchVertex
+{
+    glm::vec3 Position;
+    glm::vec2 TexCoord;
+    //Which layer of a bound TextureArray to sample, ignored by shaders sampling a plain Texture
+    //A float because that's all glVertexAttribPointer hands the shader, whole numbers are exact anyway
+    float Layer;
+};
+
+struct BatchStats
+{
+    //Quads submitted since the last BeginFrame
+    unsigned int QuadCount = 0;
+    //glDrawElements calls actually issued for those quads
+    unsigned int DrawCalls = 0;
+
+    //Drawing every quad on its own would have cost one draw call per quad
+    inline unsigned int GetDrawCallsSaved() const { return QuadCount > DrawCalls ? QuadCount - DrawCalls : 0; }
+};
+
+//Collects many quads into one dynamic vertex buffer and draws them with as few draw calls as possible
+//Usage per frame:
+//  BeginFrame() -> BeginBatch(shader) -> SubmitQuad(...) as many times as needed -> EndBatch()
+//Whatever texture should be sampled needs to be bound by the caller before EndBatch
+//With a TextureArray bound, each quad's layer picks its image, so one batch can draw any number of different images
+class BatchRenderer
+{
+private:
+    unsigned int m_MaxQuads;
+
+    std::unique_ptr<VertexArray> m_VAO;
+    //Every flush writes into a fresh part of this, so we never wait on the GPU to finish reading the previous flush
+    std::unique_ptr<StreamingBuffer> m_VertexStream;
+    //Stream's grow count when m_VAO was set up, the VAO needs rebuilding when it changes
+    unsigned int m_StreamGrowCount;
+    //Same 0,1,2,2,3,0 pattern repeated for every quad, so it's built once and shared by every flush
+    std::unique_ptr<IndexBuffer> m_IndexBuffer;
+
+    //CPU side staging for the current batch, uploaded in one go on Flush
+    std::vector<BatchVertex> m_Vertices;
+    const Shader* m_Shader;
+    Renderer m_Renderer;
+    BatchStats m_Stats;
+public:
+    BatchRenderer(unsigned int maxQuads = 10000);
+    ~BatchRenderer();
+
+    void BeginBatch(const Shader& shader);
+    //Unit quad centered on 0,0 scaled by size and then moved by transform
+    void SubmitQuad(const glm::mat4& transform, const glm::vec2& size);
+    void SubmitQuad(const glm::vec3& position, const glm::vec2& size);
+    //Same but only samples the uvMin to uvMax part of the texture, e.g. one image out of a TextureAtlas page
+    //layer is the TextureArray layer to sample, if one is bound
+    void SubmitQuad(const glm::mat4& transform, const glm::vec2& size, const glm::vec2& uvMin, const glm::vec2& uvMax, unsigned int layer = 0);
+    void SubmitQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec2& uvMin, const glm::vec2& uvMax, unsigned int layer = 0);
+    void EndBatch();
+
+    //Call once per frame, resets the stats and moves the vertex stream on to a new region
+    void BeginFrame();
+    inline const BatchStats& GetStats() const { return m_Stats; }
+    inline unsigned int GetMaxQuads() const { return m_MaxQuads; }
+private:
+    //Points a new vertex array at the current vertex stream buffer
+    void CreateVertexArray();
+    //Draws whatever has been submitted so far and empties the batch
+    void Flush();
+};
+
+#endif /* BatchRenderer_hpp */
@@ -0,0 +1,113 @@
+//
+//  Benchmark.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "Benchmark.hpp"
+#include "Renderer.h"
+
+#include <fstream>
+#include <iostream>
+
+//Test names and GL strings are plain text, only quotes and backslashes need escaping
+static std::string JsonString(const std::string& text)
+{
+    std::string escaped = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+static void WriteTimes(std::ofstream& out, const char* name, const std::vector<float>& values)
+{
+    float average = 0.0f;
+    for (float value : values)
+        average += value;
+    if (!values.empty())
+        average /= values.size();
+    
+    out << "      " << JsonString(name) << ": { "
+        << "\"avg\": " << average
+        << ", \"min\": " << FrameTimings::GetPercentile(values, 0.0f)
+        << ", \"p50\": " << FrameTimings::GetPercentile(values, 50.0f)
+        << ", \"p95\": " << FrameTimings::GetPercentile(values, 95.0f)
+        << ", \"p99\": " << FrameTimings::GetPercentile(values, 99.0f)
+        << ", \"max\": " << FrameTimings::GetPercentile(values, 100.0f)
+        << " }";
+}
+
+Benchmark::Benchmark(HeadlessRunner& runner, unsigned int warmupFrames, unsigned int frames)
+    : m_Runner(runner), m_WarmupFrames(warmupFrames), m_Frames(frames)
+{
+}
+
+bool Benchmark::Run(const test::TestMenu& menu, const std::string& testName)
+{
+    bool found = false;
+    for (auto& entry : menu.GetTests())
+    {
+        if (!testName.empty() && entry.first != testName)
+            continue;
+        found = true;
+        
+        test::Test* test = entry.second();
+        m_Runner.Run(*test, m_WarmupFrames);
+        BenchmarkResult result;
+        result.Name = entry.first;
+        result.Timings = m_Runner.Run(*test, m_Frames);
+        delete test;
+        
+        const FrameTimings& timings = result.Timings;
+        std::cout << entry.first << ": p50 " << FrameTimings::GetPercentile(timings.FrameMs, 50.0f)
+            << " ms, p95 " << FrameTimings::GetPercentile(timings.FrameMs, 95.0f)
+            << " ms, p99 " << FrameTimings::GetPercentile(timings.FrameMs, 99.0f)
+            << " ms, GPU p50 " << FrameTimings::GetPercentile(timings.GpuMs, 50.0f)
+            << " ms, " << timings.GetAverageDrawCalls() << " draw calls/frame" << std::endl;
+        m_Results.push_back(result);
+    }
+    return found;
+}
+
+bool Benchmark::WriteJson(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cout << "Can't write benchmark results to " << path << std::endl;
+        return false;
+    }
+    
+    //Numbers from different machines or drivers aren't comparable, so say where they came from
+    out << "{\n";
+    out << "  \"renderer\": " << JsonString((const char*)glGetString(GL_RENDERER)) << ",\n";
+    out << "  \"version\": " << JsonString((const char*)glGetString(GL_VERSION)) << ",\n";
+    out << "  \"warmup_frames\": " << m_WarmupFrames << ",\n";
+    out << "  \"frames\": " << m_Frames << ",\n";
+    out << "  \"tests\": [\n";
+    for (size_t i = 0; i < m_Results.size(); i++)
+    {
+        const BenchmarkResult& result = m_Results[i];
+        out << "    {\n";
+        out << "      \"name\": " << JsonString(result.Name) << ",\n";
+        WriteTimes(out, "cpu_ms", result.Timings.FrameMs);
+        out << ",\n";
+        WriteTimes(out, "gpu_ms", result.Timings.GpuMs);
+        out << ",\n";
+        out << "      \"draw_calls_per_frame\": " << result.Timings.GetAverageDrawCalls() << ",\n";
+        //Average GPU ms per frame of each GPUProfiler scope
+        out << "      \"gpu_scopes_ms\": {";
+        for (auto it = result.Timings.GpuScopeMs.begin(); it != result.Timings.GpuScopeMs.end(); ++it)
+            out << (it == result.Timings.GpuScopeMs.begin() ? " " : ", ") << JsonString(it->first) << ": " << it->second;
+        out << " }\n";
+        out << "    }" << (i + 1 < m_Results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return true;
+}
@@ -0,0 +1,46 @@
+//
+//  Benchmark.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef Benchmark_hpp
+#define Benchmark_hpp
+
+#include <string>
+#include <vector>
+
+#include "HeadlessRunner.hpp"
+
+struct BenchmarkResult
+{
+    std::string Name;
+    //Measured frames only, warm up frames are thrown away
+    FrameTimings Timings;
+};
+
+//Runs every test registered in a TestMenu through a HeadlessRunner and collects timings we can diff between commits
+//Each test is constructed fresh, run for some warm up frames (shader compiles, async texture loads, driver
+//first use costs) and then measured for a fixed number of frames
+class Benchmark
+{
+private:
+    HeadlessRunner& m_Runner;
+    unsigned int m_WarmupFrames;
+    unsigned int m_Frames;
+    std::vector<BenchmarkResult> m_Results;
+public:
+    Benchmark(HeadlessRunner& runner, unsigned int warmupFrames = 60, unsigned int frames = 300);
+    
+    //Runs every registered test, or only the one called testName if it isn't empty
+    //Returns false if nothing matched
+    bool Run(const test::TestMenu& menu, const std::string& testName = "");
+    
+    //CPU and GPU frame time percentiles and draw calls per test, plus what GPU/driver it ran on
+    bool WriteJson(const std::string& path) const;
+    
+    inline const std::vector<BenchmarkResult>& GetResults() const { return m_Results; }
+};
+
+#endif /* Benchmark_hpp */
@@ -0,0 +1,155 @@
+//
+//  CPUProfiler.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "CPUProfiler.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+namespace {
+
+    //Written by whichever thread claimed the slot while WriteChromeTrace may be reading it, so every field is atomic
+    //(relaxed loads and stores are plain moves on the CPUs we run on). Sequence is 1 + the index the zone was recorded
+    //at once it's completely written, 0 while it's being written
+    struct Zone
+    {
+        std::atomic<unsigned long long> Sequence;
+        std::atomic<const char*> Name;
+        std::atomic<unsigned int> ThreadId;
+        std::atomic<long long> Start;
+        std::atomic<long long> Duration;
+    };
+    
+    //Plain copy of a zone for writing out
+    struct ZoneSnapshot
+    {
+        const char* Name;
+        unsigned int ThreadId;
+        long long Start;
+        long long Duration;
+    };
+
+}
+
+static Zone s_Zones[CPUProfiler::Capacity];
+//Total zones ever recorded, the slot to write is this modulo Capacity
+//fetch_add hands every thread its own slot so recording never takes a lock
+static std::atomic<unsigned long long> s_Next(0);
+
+static const std::chrono::steady_clock::time_point s_Start = std::chrono::steady_clock::now();
+
+//Small sequential ids read better in the trace viewer than std::thread::id hashes
+static std::atomic<unsigned int> s_NextThreadId(1);
+static thread_local unsigned int s_ThreadId = s_NextThreadId++;
+
+static std::mutex s_ThreadNamesMutex;
+static std::map<unsigned int, std::string> s_ThreadNames;
+
+void CPUProfiler::Record(const char* name, long long startUs, long long durationUs)
+{
+    unsigned long long index = s_Next.fetch_add(1, std::memory_order_relaxed);
+    Zone& zone = s_Zones[index % Capacity];
+    //Marked unfinished before any field changes, and only published again once they all have
+    zone.Sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    zone.Name.store(name, std::memory_order_relaxed);
+    zone.ThreadId.store(s_ThreadId, std::memory_order_relaxed);
+    zone.Start.store(startUs, std::memory_order_relaxed);
+    zone.Duration.store(durationUs, std::memory_order_relaxed);
+    zone.Sequence.store(index + 1, std::memory_order_release);
+}
+
+//False if the zone recorded at index isn't finished yet, or was overwritten by a newer one while it was being copied
+static bool ReadZone(unsigned long long index, ZoneSnapshot& snapshot)
+{
+    const Zone& zone = s_Zones[index % CPUProfiler::Capacity];
+    if (zone.Sequence.load(std::memory_order_acquire) != index + 1)
+        return false;
+    snapshot.Name = zone.Name.load(std::memory_order_relaxed);
+    snapshot.ThreadId = zone.ThreadId.load(std::memory_order_relaxed);
+    snapshot.Start = zone.Start.load(std::memory_order_relaxed);
+    snapshot.Duration = zone.Duration.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return zone.Sequence.load(std::memory_order_relaxed) == index + 1 && snapshot.Name;
+}
+
+void CPUProfiler::SetThreadName(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(s_ThreadNamesMutex);
+    s_ThreadNames[s_ThreadId] = name;
+}
+
+long long CPUProfiler::Now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_Start).count();
+}
+
+//Function names from __PRETTY_FUNCTION__ can have quotes in them (e.g. default arguments)
+static void WriteJsonString(std::ofstream& out, const char* text)
+{
+    out << '"';
+    for (; *text; text++)
+    {
+        if (*text == '"' || *text == '\\')
+            out << '\\';
+        out << *text;
+    }
+    out << '"';
+}
+
+bool CPUProfiler::WriteChromeTrace(const std::string& path)
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cout << "Can't write CPU trace to " << path << std::endl;
+        return false;
+    }
+    
+    unsigned long long end = s_Next.load(std::memory_order_acquire);
+    unsigned long long begin = end > Capacity ? end - Capacity : 0;
+    
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(s_ThreadNamesMutex);
+        for (auto& thread : s_ThreadNames)
+        {
+            out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.first << ",\"args\":{\"name\":";
+            WriteJsonString(out, thread.second.c_str());
+            out << "}}";
+            first = false;
+        }
+    }
+    //Complete events ("X") carry their own duration, so begin/end pairs don't need matching up
+    unsigned long long written = 0;
+    for (unsigned long long i = begin; i < end; i++)
+    {
+        //Other threads keep recording while this runs, zones they're in the middle of are left out
+        ZoneSnapshot zone;
+        if (!ReadZone(i, zone))
+            continue;
+        out << (first ? "" : ",\n") << "{\"name\":";
+        WriteJsonString(out, zone.Name);
+        out << ",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":" << zone.Start << ",\"dur\":" << zone.Duration
+            << ",\"pid\":1,\"tid\":" << zone.ThreadId << "}";
+        first = false;
+        written++;
+    }
+    out << "\n]}\n";
+    
+    std::cout << "Wrote " << written << " CPU zones to " << path << std::endl;
+    return true;
+}
+
+unsigned long long CPUProfiler::GetRecordedCount()
+{
+    return s_Next.load(std::memory_order_relaxed);
+}
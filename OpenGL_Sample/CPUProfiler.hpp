@@ -0,0 +1,67 @@
+//
+//  CPUProfiler.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef CPUProfiler_hpp
+#define CPUProfiler_hpp
+
+#include <chrono>
+#include <string>
+
+//Scoped CPU timing zones, written to a ring buffer and saved as Chrome trace_event JSON
+//Open the file in chrome://tracing or ui.perfetto.dev to see where startup and frame time go
+//Set CPU_PROFILER_ENABLED to 0 and every CPU_PROFILE_* macro compiles to nothing
+#ifndef CPU_PROFILER_ENABLED
+    #define CPU_PROFILER_ENABLED 1
+#endif
+
+class CPUProfiler
+{
+public:
+    //Oldest zones get overwritten once this many have been recorded, about 1.5MB
+    static const unsigned int Capacity = 65536;
+    
+    //Safe to call from any thread, name has to be a string literal (or live as long as the profiler)
+    static void Record(const char* name, long long startUs, long long durationUs);
+    //Shows up as the track name in the trace viewer, call once from the thread being named
+    static void SetThreadName(const std::string& name);
+    
+    //Microseconds since the profiler started
+    static long long Now();
+    
+    //Writes everything still in the ring. Safe while other threads are recording,
+    //zones they're still in the middle of writing (or overwrite while this runs) are just left out
+    static bool WriteChromeTrace(const std::string& path);
+    //Zones recorded since startup, including the ones that have been overwritten
+    static unsigned long long GetRecordedCount();
+};
+
+//Times the enclosing block
+class CPUProfileScope
+{
+private:
+    const char* m_Name;
+    long long m_Start;
+public:
+    CPUProfileScope(const char* name)
+        : m_Name(name), m_Start(CPUProfiler::Now()) {}
+    ~CPUProfileScope() { CPUProfiler::Record(m_Name, m_Start, CPUProfiler::Now() - m_Start); }
+};
+
+#if CPU_PROFILER_ENABLED
+    //Two levels so __LINE__ gets expanded before it's pasted onto the variable name
+    #define CPU_PROFILE_CONCAT_INNER(a, b) a##b
+    #define CPU_PROFILE_CONCAT(a, b) CPU_PROFILE_CONCAT_INNER(a, b)
+    #define CPU_PROFILE_SCOPE(name) CPUProfileScope CPU_PROFILE_CONCAT(cpuProfileScope, __LINE__)(name)
+    #define CPU_PROFILE_FUNCTION() CPU_PROFILE_SCOPE(__PRETTY_FUNCTION__)
+    #define CPU_PROFILE_THREAD(name) CPUProfiler::SetThreadName(name)
+#else
+    #define CPU_PROFILE_SCOPE(name)
+    #define CPU_PROFILE_FUNCTION()
+    #define CPU_PROFILE_THREAD(name)
+#endif
+
+#endif /* CPUProfiler_hpp */
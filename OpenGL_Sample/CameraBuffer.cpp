@@ -0,0 +1,50 @@
+//
+//  CameraBuffer.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "CameraBuffer.hpp"
+
+#include <cstring>
+
+//Registered before main runs so every Shader, whenever it's created, gets pointed at binding 0
+[[maybe_unused]] static const bool s_Registered = (UniformBuffer::RegisterBlock("Camera", CameraBuffer::Binding, CameraBuffer::GetLayout().GetSize()), true);
+
+Std140Layout CameraBuffer::GetLayout(unsigned int* viewOffset, unsigned int* projectionOffset, unsigned int* viewProjectionOffset)
+{
+    Std140Layout layout;
+    unsigned int view = layout.Push<glm::mat4>();
+    unsigned int projection = layout.Push<glm::mat4>();
+    unsigned int viewProjection = layout.Push<glm::mat4>();
+    if (viewOffset)
+        *viewOffset = view;
+    if (projectionOffset)
+        *projectionOffset = projection;
+    if (viewProjectionOffset)
+        *viewProjectionOffset = viewProjection;
+    return layout;
+}
+
+CameraBuffer::CameraBuffer()
+{
+    Std140Layout layout = GetLayout(&m_ViewOffset, &m_ProjectionOffset, &m_ViewProjectionOffset);
+    m_Staging.resize(layout.GetSize());
+    m_Buffer = std::make_unique<UniformBuffer>(layout.GetSize(), Binding);
+}
+
+CameraBuffer::~CameraBuffer()
+{
+}
+
+void CameraBuffer::Set(const glm::mat4& view, const glm::mat4& projection)
+{
+    glm::mat4 viewProjection = projection * view;
+    memcpy(&m_Staging[m_ViewOffset], &view[0][0], sizeof(glm::mat4));
+    memcpy(&m_Staging[m_ProjectionOffset], &projection[0][0], sizeof(glm::mat4));
+    memcpy(&m_Staging[m_ViewProjectionOffset], &viewProjection[0][0], sizeof(glm::mat4));
+    //Another CameraBuffer (e.g. from the previous test) may have taken the binding point
+    m_Buffer->BindBase();
+    m_Buffer->SetData(m_Staging.data(), (unsigned int)m_Staging.size());
+}
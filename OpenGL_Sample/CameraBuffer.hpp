@@ -0,0 +1,46 @@
+//
+//  CameraBuffer.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef CameraBuffer_hpp
+#define CameraBuffer_hpp
+
+#include <memory>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "UniformBuffer.hpp"
+
+//The per frame Camera uniform block every shader can read, always on binding point 0
+//Shader side it looks like:
+//  layout(std140) uniform Camera
+//  {
+//      mat4 u_View;
+//      mat4 u_Projection;
+//      mat4 u_ViewProjection;
+//  };
+//Set it once per frame and every program sees the new matrices without any per draw uniform uploads
+class CameraBuffer
+{
+private:
+    std::unique_ptr<UniformBuffer> m_Buffer;
+    unsigned int m_ViewOffset, m_ProjectionOffset, m_ViewProjectionOffset;
+    //Whole block is built here and uploaded in one go
+    std::vector<unsigned char> m_Staging;
+public:
+    static constexpr unsigned int Binding = 0;
+    
+    CameraBuffer();
+    ~CameraBuffer();
+    
+    void Set(const glm::mat4& view, const glm::mat4& projection);
+    
+    //std140 layout of the block above, shared with RegisterBlock so shaders that disagree get a warning
+    static Std140Layout GetLayout(unsigned int* viewOffset = nullptr, unsigned int* projectionOffset = nullptr, unsigned int* viewProjectionOffset = nullptr);
+};
+
+#endif /* CameraBuffer_hpp */
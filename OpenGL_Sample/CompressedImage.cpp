@@ -0,0 +1,538 @@
+//
+//  CompressedImage.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "CompressedImage.hpp"
+#include "CPUProfiler.hpp"
+#include "TextureCompressor.hpp"
+#include "Renderer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+//Both containers are little endian, as is every machine this runs on
+static uint32_t ReadU32(const unsigned char* p)
+{
+    uint32_t value;
+    memcpy(&value, p, 4);
+    return value;
+}
+
+static uint64_t ReadU64(const unsigned char* p)
+{
+    uint64_t value;
+    memcpy(&value, p, 8);
+    return value;
+}
+
+static bool ReadFile(const std::string& path, std::vector<unsigned char>& contents)
+{
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream)
+        return false;
+    std::streamsize size = stream.tellg();
+    contents.resize((size_t)size);
+    stream.seekg(0);
+    return size == 0 || (bool)stream.read((char*)contents.data(), size);
+}
+
+static bool HasExtension(const std::string& path, const char* extension)
+{
+    size_t length = strlen(extension);
+    if (path.size() < length)
+        return false;
+    for (size_t i = 0; i < length; i++)
+        if (tolower(path[path.size() - length + i]) != extension[i])
+            return false;
+    return true;
+}
+
+//The renderer never converts to linear (PNGs go up as plain GL_RGBA8 too), so sRGB variants map to the same
+//format as their UNORM twin and look exactly like the PNG they came from
+static unsigned int FormatFromDXGI(uint32_t dxgi)
+{
+    switch (dxgi)
+    {
+        case 71: case 72: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case 77: case 78: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case 98: case 99: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        default:          return 0;
+    }
+}
+
+static unsigned int FormatFromVulkan(uint32_t vkFormat)
+{
+    switch (vkFormat)
+    {
+        case 131: case 132: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case 133: case 134: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case 137: case 138: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case 145: case 146: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case 147: case 148: return GL_COMPRESSED_RGB8_ETC2;
+        case 149: case 150: return GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+        case 151: case 152: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        default:            return 0;
+    }
+}
+
+//Levels past 1x1 would just be more 1x1 levels, a broken header could ask for billions of them
+static int ClampLevelCount(int levelCount, int width, int height)
+{
+    int maxLevels = 1;
+    for (int size = std::max(width, height); size > 1; size /= 2)
+        maxLevels++;
+    return std::min(std::max(levelCount, 1), maxLevels);
+}
+
+//Widths and heights come straight from the header, a broken (or hostile) one could ask for terabytes
+//16384 is as big as GL_MAX_TEXTURE_SIZE gets on the drivers we run on, and loading can happen on a thread without GL to ask
+static const uint32_t s_MaxSize = 16384;
+
+static bool CheckSize(const std::string& path, uint32_t width, uint32_t height)
+{
+    if (width == 0 || height == 0)
+    {
+        std::cout << path << " is empty" << std::endl;
+        return false;
+    }
+    if (width > s_MaxSize || height > s_MaxSize)
+    {
+        std::cout << path << " is " << width << "x" << height << ", over the " << s_MaxSize << " pixel limit" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//Bytes every level together takes, so it can be checked against the file before allocating any of it
+static size_t GetChainSize(unsigned int format, int width, int height, int levelCount)
+{
+    size_t size = 0;
+    for (int level = 0; level < levelCount; level++)
+    {
+        size += CompressedImage::GetLevelSize(format, width, height);
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return size;
+}
+
+//  "DDS " + 124 byte header (+ 20 byte DX10 header when the FourCC is "DX10"), then every level, biggest first
+static bool LoadDDS(const std::string& path, const std::vector<unsigned char>& file, CompressedImage& image)
+{
+    if (file.size() < 128 || memcmp(file.data(), "DDS ", 4) != 0 || ReadU32(&file[4]) != 124)
+    {
+        std::cout << path << " isn't a DDS file" << std::endl;
+        return false;
+    }
+    image.Height = (int)ReadU32(&file[12]);
+    image.Width = (int)ReadU32(&file[16]);
+    //Files without DDSD_MIPMAPCOUNT leave this at 0
+    int levelCount = ClampLevelCount((int)ReadU32(&file[28]), image.Width, image.Height);
+    
+    //Pixel format starts at 76, FourCC at 84
+    size_t dataOffset = 128;
+    const unsigned char* fourCC = &file[84];
+    if (memcmp(fourCC, "DXT1", 4) == 0)
+        image.Format = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    else if (memcmp(fourCC, "DXT5", 4) == 0)
+        image.Format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    else if (memcmp(fourCC, "DX10", 4) == 0 && file.size() >= 148)
+    {
+        image.Format = FormatFromDXGI(ReadU32(&file[128]));
+        //Resource dimension 3 is a 2D texture, array size is at 140
+        if (ReadU32(&file[132]) != 3 || ReadU32(&file[140]) > 1)
+        {
+            std::cout << path << " isn't a plain 2D texture, only those are supported" << std::endl;
+            return false;
+        }
+        dataOffset = 148;
+    }
+    if (!CheckSize(path, ReadU32(&file[16]), ReadU32(&file[12])))
+        return false;
+    if (!image.Format)
+    {
+        std::cout << path << " uses a DDS format that isn't supported (BC1, BC3 and BC7 are)" << std::endl;
+        return false;
+    }
+    if (file.size() < dataOffset + GetChainSize(image.Format, image.Width, image.Height, levelCount))
+    {
+        std::cout << path << " is cut short" << std::endl;
+        return false;
+    }
+    
+    image.AllocateLevels(levelCount);
+    //Levels are already packed in order after the header
+    memcpy(image.Data.data(), &file[dataOffset], image.Data.size());
+    return true;
+}
+
+//KTXorientation is "rd" (rows go down, the default) or "ru" (rows go up, like GL)
+static bool IsBottomUp(const unsigned char* keyValues, size_t length)
+{
+    size_t offset = 0;
+    while (offset + 4 <= length)
+    {
+        uint32_t entryLength = ReadU32(keyValues + offset);
+        if (offset + 4 + entryLength > length)
+            break;
+        const char* entry = (const char*)keyValues + offset + 4;
+        if (entryLength > 16 && memcmp(entry, "KTXorientation", 15) == 0)
+            return entry[16] == 'u';
+        //Every entry is padded to 4 bytes
+        offset += 4 + ((entryLength + 3) & ~3u);
+    }
+    return false;
+}
+
+//  12 byte identifier, 68 byte header and index, then one {offset, length, uncompressed length} per level
+//Levels can be anywhere in the file (the spec puts the smallest first), so they're copied out one by one
+static bool LoadKTX2(const std::string& path, const std::vector<unsigned char>& file, CompressedImage& image)
+{
+    static const unsigned char s_Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+    if (file.size() < 80 || memcmp(file.data(), s_Identifier, 12) != 0)
+    {
+        std::cout << path << " isn't a KTX2 file" << std::endl;
+        return false;
+    }
+    image.Format = FormatFromVulkan(ReadU32(&file[12]));
+    image.Width = (int)ReadU32(&file[20]);
+    image.Height = (int)ReadU32(&file[24]);
+    uint32_t depth = ReadU32(&file[28]), layers = ReadU32(&file[32]), faces = ReadU32(&file[36]);
+    //0 means the file wants mipmaps generated, which can't be done for compressed formats
+    int levelCount = ClampLevelCount((int)ReadU32(&file[40]), image.Width, image.Height);
+    uint32_t supercompression = ReadU32(&file[44]);
+    
+    if (!image.Format)
+    {
+        std::cout << path << " uses a KTX2 format that isn't supported (BC1, BC3, BC7 and ETC2 are)" << std::endl;
+        return false;
+    }
+    if (depth > 1 || layers > 1 || faces != 1)
+    {
+        std::cout << path << " isn't a plain 2D texture, only those are supported" << std::endl;
+        return false;
+    }
+    //Basis Universal or zstd on top, would need transcoding first
+    if (supercompression != 0)
+    {
+        std::cout << path << " is supercompressed, re-encode it without --zcmp or --bcmp" << std::endl;
+        return false;
+    }
+    if (!CheckSize(path, ReadU32(&file[20]), ReadU32(&file[24])))
+        return false;
+    //Level index has to be there, and the levels can't add up to more than the whole file
+    if (file.size() < 80 + (size_t)levelCount * 24 || file.size() < GetChainSize(image.Format, image.Width, image.Height, levelCount))
+    {
+        std::cout << path << " is cut short" << std::endl;
+        return false;
+    }
+    
+    uint32_t keyValueOffset = ReadU32(&file[56]), keyValueLength = ReadU32(&file[60]);
+    if ((size_t)keyValueOffset + keyValueLength <= file.size())
+        image.BottomUp = IsBottomUp(&file[keyValueOffset], keyValueLength);
+    
+    image.AllocateLevels(levelCount);
+    for (int level = 0; level < levelCount; level++)
+    {
+        uint64_t offset = ReadU64(&file[80 + level * 24]);
+        uint64_t length = ReadU64(&file[80 + level * 24 + 8]);
+        const CompressedImage::Level& info = image.Levels[level];
+        //Written so a huge offset can't wrap around past the end check
+        if (length != info.Size || offset > file.size() || length > file.size() - offset)
+        {
+            std::cout << path << " has a bad level " << level << std::endl;
+            return false;
+        }
+        memcpy(&image.Data[info.Offset], &file[(size_t)offset], info.Size);
+    }
+    return true;
+}
+
+bool CompressedImage::Load(const std::string& path, CompressedImage& image)
+{
+    CPU_PROFILE_FUNCTION();
+    image = CompressedImage();
+    std::vector<unsigned char> file;
+    if (!ReadFile(path, file))
+    {
+        std::cout << "Failed to open " << path << std::endl;
+        return false;
+    }
+    
+    bool loaded = HasExtension(path, ".dds") ? LoadDDS(path, file, image) : LoadKTX2(path, file, image);
+    if (!loaded)
+    {
+        image = CompressedImage();
+        return false;
+    }
+    
+    //Done here so it happens on whatever thread is loading, GL wants the bottom row first
+    if (!image.BottomUp)
+        image.FlipVertically();
+    return true;
+}
+
+bool CompressedImage::IsCompressedPath(const std::string& path)
+{
+    return HasExtension(path, ".dds") || HasExtension(path, ".ktx2");
+}
+
+bool CompressedImage::IsFormatSupported(unsigned int format)
+{
+    switch (format)
+    {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            return GLEW_EXT_texture_compression_s3tc;
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+            return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+            return GLEW_VERSION_4_3 || GLEW_ARB_ES3_compatibility;
+        default:
+            return false;
+    }
+}
+
+const char* CompressedImage::GetFormatName(unsigned int format)
+{
+    switch (format)
+    {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:             return "BC1";
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:            return "BC1 (1 bit alpha)";
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:            return "BC3";
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:               return "BC7";
+        case GL_COMPRESSED_RGB8_ETC2:                     return "ETC2 RGB";
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2: return "ETC2 RGB (1 bit alpha)";
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:                return "ETC2 RGBA";
+        default:                                          return "unknown";
+    }
+}
+
+unsigned int CompressedImage::GetBlockSize(unsigned int format)
+{
+    switch (format)
+    {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            return 8;
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+void CompressedImage::AllocateLevels(int levelCount)
+{
+    int width = Width, height = Height;
+    size_t offset = 0;
+    Levels.clear();
+    for (int level = 0; level < levelCount; level++)
+    {
+        Level info;
+        info.Width = width;
+        info.Height = height;
+        info.Offset = offset;
+        info.Size = GetLevelSize(Format, width, height);
+        Levels.push_back(info);
+        offset += info.Size;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    Data.resize(offset);
+}
+
+size_t CompressedImage::GetLevelSize(unsigned int format, int width, int height)
+{
+    //Partial blocks at the edges (and 1x1, 2x2 levels) still take a whole block
+    return (((size_t)width + 3) / 4) * (((size_t)height + 3) / 4) * GetBlockSize(format);
+}
+
+//Reverses the first rows rows of a BC1 color block, one byte of 2 bit indices per row after the two endpoints
+static void FlipColorBlock(unsigned char* block, int rows)
+{
+    std::reverse(block + 4, block + 4 + rows);
+}
+
+//Same for a BC3 alpha block, two endpoints then 4 rows of 12 bits (four 3 bit indices)
+static void FlipAlphaBlock(unsigned char* block, int rows)
+{
+    uint64_t bits = 0;
+    memcpy(&bits, block + 2, 6);
+    uint64_t flipped = 0;
+    for (int row = 0; row < 4; row++)
+    {
+        int from = row < rows ? rows - 1 - row : row;
+        flipped |= ((bits >> (from * 12)) & 0xFFF) << (row * 12);
+    }
+    memcpy(block + 2, &flipped, 6);
+}
+
+//565 to 888 the way decoders do it, top bits repeated into the bottom ones
+static void Unpack565(uint16_t packed, unsigned char* color)
+{
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (unsigned char)((r << 3) | (r >> 2));
+    color[1] = (unsigned char)((g << 2) | (g >> 4));
+    color[2] = (unsigned char)((b << 3) | (b >> 2));
+}
+
+//BC1 color block to 16 RGBA pixels, row 0 first. BC3 color blocks are always in 4 color mode
+static void DecodeColorBlock(const unsigned char* block, bool bc3, unsigned char* pixels)
+{
+    uint16_t c0 = (uint16_t)(block[0] | block[1] << 8), c1 = (uint16_t)(block[2] | block[3] << 8);
+    unsigned char palette[4][4];
+    Unpack565(c0, palette[0]);
+    Unpack565(c1, palette[1]);
+    for (int c = 0; c < 3; c++)
+    {
+        if (c0 > c1 || bc3)
+        {
+            palette[2][c] = (unsigned char)((2 * palette[0][c] + palette[1][c]) / 3);
+            palette[3][c] = (unsigned char)((palette[0][c] + 2 * palette[1][c]) / 3);
+        }
+        else
+        {
+            palette[2][c] = (unsigned char)((palette[0][c] + palette[1][c]) / 2);
+            palette[3][c] = 0;
+        }
+    }
+    for (int i = 0; i < 4; i++)
+        palette[i][3] = 255;
+    
+    uint32_t indices = ReadU32(block + 4);
+    for (int i = 0; i < 16; i++)
+        memcpy(pixels + i * 4, palette[(indices >> (i * 2)) & 3], 4);
+}
+
+//BC3 alpha block into the alpha of 16 RGBA pixels
+static void DecodeAlphaBlock(const unsigned char* block, unsigned char* pixels)
+{
+    int a0 = block[0], a1 = block[1];
+    int palette[8] = { a0, a1 };
+    if (a0 > a1)
+    {
+        for (int i = 1; i < 7; i++)
+            palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+    }
+    else
+    {
+        for (int i = 1; i < 5; i++)
+            palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    uint64_t bits = 0;
+    memcpy(&bits, block + 2, 6);
+    for (int i = 0; i < 16; i++)
+        pixels[i * 4 + 3] = (unsigned char)palette[(bits >> (i * 3)) & 7];
+}
+
+//Flips a level whose last block row is only partly used. The padding rows end up at the top, so every block
+//would need rows from two different blocks (each with its own endpoints). Decodes the level, flips the pixels
+//and encodes it again, a little lossy but only ever needed for odd sized levels
+static void ReencodeFlipped(const CompressedImage::Level& level, bool bc3, unsigned char* data)
+{
+    unsigned int blockSize = bc3 ? 16 : 8;
+    int blocksWide = (level.Width + 3) / 4;
+    int blocksHigh = (level.Height + 3) / 4;
+    std::vector<unsigned char> pixels((size_t)level.Width * level.Height * 4);
+    unsigned char texels[16 * 4];
+    for (int by = 0; by < blocksHigh; by++)
+    {
+        for (int bx = 0; bx < blocksWide; bx++)
+        {
+            const unsigned char* block = data + ((size_t)by * blocksWide + bx) * blockSize;
+            DecodeColorBlock(bc3 ? block + 8 : block, bc3, texels);
+            if (bc3)
+                DecodeAlphaBlock(block, texels);
+            //Padding texels are thrown away, each row goes to its mirrored position
+            for (int y = 0; y < 4 && by * 4 + y < level.Height; y++)
+            {
+                int row = level.Height - 1 - (by * 4 + y);
+                for (int x = 0; x < 4 && bx * 4 + x < level.Width; x++)
+                    memcpy(&pixels[((size_t)row * level.Width + bx * 4 + x) * 4], &texels[(y * 4 + x) * 4], 4);
+            }
+        }
+    }
+    
+    for (int by = 0; by < blocksHigh; by++)
+    {
+        for (int bx = 0; bx < blocksWide; bx++)
+        {
+            //Blocks hanging off the edge repeat the last row and column, same as TextureCompressor::Compress
+            for (int y = 0; y < 4; y++)
+                for (int x = 0; x < 4; x++)
+                    memcpy(&texels[(y * 4 + x) * 4], &pixels[((size_t)std::min(by * 4 + y, level.Height - 1) * level.Width + std::min(bx * 4 + x, level.Width - 1)) * 4], 4);
+            unsigned char* block = data + ((size_t)by * blocksWide + bx) * blockSize;
+            if (bc3)
+                TextureCompressor::EncodeBC3Block(texels, block);
+            else
+                TextureCompressor::EncodeBC1Block(texels, block);
+        }
+    }
+}
+
+//A level taller than one block whose height isn't a multiple of 4 can't be flipped by moving rows around
+static bool HasPartialBlockRow(const CompressedImage::Level& level)
+{
+    return level.Height > 4 && level.Height % 4 != 0;
+}
+
+bool CompressedImage::FlipVertically()
+{
+    bool bc1 = Format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT || Format == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    bool bc3 = Format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    if (!bc1 && !bc3)
+        return false;
+    //The BC1 encoder has no 1 bit alpha, so those levels can't be encoded again. Checked first so nothing is half flipped
+    if (Format == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT && std::any_of(Levels.begin(), Levels.end(), HasPartialBlockRow))
+        return false;
+    
+    unsigned int blockSize = GetBlockSize(Format);
+    for (const Level& level : Levels)
+    {
+        unsigned char* data = &Data[level.Offset];
+        if (HasPartialBlockRow(level))
+        {
+            ReencodeFlipped(level, bc3, data);
+            continue;
+        }
+        
+        int blocksWide = (level.Width + 3) / 4;
+        int blocksHigh = (level.Height + 3) / 4;
+        //Every block row is full here, apart from levels under 4 pixels high where the one row is all there is
+        int rows = std::min(level.Height, 4);
+        size_t rowSize = (size_t)blocksWide * blockSize;
+        
+        //Swap whole rows of blocks, then flip the rows inside every block
+        for (int y = 0; y < blocksHigh / 2; y++)
+            std::swap_ranges(data + y * rowSize, data + (y + 1) * rowSize, data + (blocksHigh - 1 - y) * rowSize);
+        for (size_t block = 0; block < (size_t)blocksWide * blocksHigh; block++)
+        {
+            unsigned char* p = data + block * blockSize;
+            if (bc3)
+            {
+                FlipAlphaBlock(p, rows);
+                p += 8;
+            }
+            FlipColorBlock(p, rows);
+        }
+    }
+    BottomUp = !BottomUp;
+    return true;
+}
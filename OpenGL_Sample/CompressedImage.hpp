@@ -0,0 +1,61 @@
+//
+//  CompressedImage.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef CompressedImage_hpp
+#define CompressedImage_hpp
+
+#include <string>
+#include <vector>
+
+//Block compressed image read straight out of a .dds or .ktx2 file, ready for glCompressedTexImage2D
+//  - BC1 (DXT1) and BC3 (DXT5) through EXT_texture_compression_s3tc
+//  - BC7 through ARB_texture_compression_bptc (GL 4.2)
+//  - ETC2 through ARB_ES3_compatibility (GL 4.3)
+//The GPU decodes these itself, so there's no decode at load and a BC1 texture takes an eighth of the memory RGBA8 does
+//Both formats store the top row first, Load flips BC1 and BC3 images so the bottom row comes first like GL expects
+struct CompressedImage
+{
+    struct Level
+    {
+        int Width = 0, Height = 0;
+        //Into Data
+        size_t Offset = 0, Size = 0;
+    };
+    
+    //GL_COMPRESSED_RGBA_S3TC_DXT5_EXT etc.
+    unsigned int Format = 0;
+    int Width = 0, Height = 0;
+    //Level 0 first
+    std::vector<Level> Levels;
+    std::vector<unsigned char> Data;
+    //True if the first row in Data is the bottom of the image, which is what GL wants
+    //Only false for BC7 and ETC2 images that weren't encoded that way (KTXorientation "ru", or toktx --lower_left_maps_to_s0t0)
+    bool BottomUp = false;
+    
+    //False (with a message) if the file is missing, isn't a format we know, or is cut short
+    //Doesn't need a context, so it's fine on a worker thread
+    static bool Load(const std::string& path, CompressedImage& image);
+    //True for the extensions Load understands
+    static bool IsCompressedPath(const std::string& path);
+    
+    //Whether this driver can sample format, needs a context
+    static bool IsFormatSupported(unsigned int format);
+    static const char* GetFormatName(unsigned int format);
+    //Bytes in one 4x4 block, 0 for a format we don't know
+    static unsigned int GetBlockSize(unsigned int format);
+    static size_t GetLevelSize(unsigned int format, int width, int height);
+    
+    //Fills in Levels for Format, Width and Height (halving down from level 0), packed one after another in Data
+    void AllocateLevels(int levelCount);
+    
+    //Turns the image upside down by reordering the rows inside each block, false if the format can't be flipped that way
+    //BC1 and BC3 blocks keep one row per byte (or 12 bits for BC3 alpha), BC7 and ETC2 mix rows together
+    //Levels whose height isn't a multiple of 4 (6, 10...) are decoded and encoded again instead, which BC1 with 1 bit alpha can't do
+    bool FlipVertically();
+};
+
+#endif /* CompressedImage_hpp */
@@ -0,0 +1,60 @@
+//
+//  Framebuffer.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "Framebuffer.hpp"
+#include "Renderer.h"
+
+#include <iostream>
+
+Framebuffer::Framebuffer(int width, int height)
+    : m_RendererID(0), m_ColorAttachment(0), m_DepthAttachment(0), m_Width(width), m_Height(height)
+{
+    GLCall(glGenFramebuffers(1, &m_RendererID));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    
+    GLCall(glGenRenderbuffers(1, &m_ColorAttachment));
+    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, m_ColorAttachment));
+    GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height));
+    GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_ColorAttachment));
+    
+    GLCall(glGenRenderbuffers(1, &m_DepthAttachment));
+    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, m_DepthAttachment));
+    GLCall(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height));
+    GLCall(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_DepthAttachment));
+    
+    GLCall(GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "Framebuffer incomplete: 0x" << std::hex << status << std::dec << std::endl;
+    
+    GLCall(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+Framebuffer::~Framebuffer()
+{
+    GLCall(glDeleteRenderbuffers(1, &m_DepthAttachment));
+    GLCall(glDeleteRenderbuffers(1, &m_ColorAttachment));
+    GLCall(glDeleteFramebuffers(1, &m_RendererID));
+}
+
+void Framebuffer::Bind() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    GLCall(glViewport(0, 0, m_Width, m_Height));
+}
+
+void Framebuffer::Unbind() const
+{
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void Framebuffer::ReadPixels(void* pixels) const
+{
+    GLCall(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_RendererID));
+    GLCall(glReadBuffer(GL_COLOR_ATTACHMENT0));
+    GLCall(glReadPixels(0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+}
@@ -0,0 +1,36 @@
+//
+//  Framebuffer.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef Framebuffer_hpp
+#define Framebuffer_hpp
+
+//Offscreen render target with an RGBA8 color buffer and a 24 bit depth buffer
+//Lets us render without a window, e.g. in headless mode where there's no default framebuffer to draw into
+class Framebuffer
+{
+private:
+    unsigned int m_RendererID;
+    //Renderbuffers since we only ever draw into them and read them back, never sample them
+    unsigned int m_ColorAttachment, m_DepthAttachment;
+    int m_Width, m_Height;
+public:
+    Framebuffer(int width, int height);
+    ~Framebuffer();
+    
+    //Also sets the viewport to cover the whole framebuffer
+    void Bind() const;
+    //Back to the default framebuffer (the window's, if there is one)
+    void Unbind() const;
+    
+    //Copies the color buffer into pixels, which needs room for width * height RGBA bytes (bottom row first)
+    void ReadPixels(void* pixels) const;
+    
+    inline int GetWidth() const { return m_Width; }
+    inline int GetHeight() const { return m_Height; }
+};
+
+#endif /* Framebuffer_hpp */
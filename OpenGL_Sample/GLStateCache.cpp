@@ -0,0 +1,171 @@
+//
+//  GLStateCache.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "GLStateCache.hpp"
+#include "Renderer.h"
+#include "RenderStats.hpp"
+
+//Nothing can have this name, so it never matches a real object and forces the next bind through
+static const unsigned int s_Unknown = 0xFFFFFFFF;
+//GL guarantees at least 16 units per stage, 32 covers every stage together on the drivers we use
+static const unsigned int s_MaxTextureSlots = 32;
+
+//Texture targets that get cached per unit, anything else is passed straight through
+static const unsigned int s_CachedTextureTargets[] = { GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY };
+static const unsigned int s_CachedTextureTargetCount = sizeof(s_CachedTextureTargets) / sizeof(s_CachedTextureTargets[0]);
+
+static unsigned int s_Program = s_Unknown;
+static unsigned int s_VertexArray = s_Unknown;
+static unsigned int s_ArrayBuffer = s_Unknown;
+//Element buffer binding is part of the vertex array's state, so it's only known for the currently bound vertex array
+static unsigned int s_ElementBuffer = s_Unknown;
+static unsigned int s_Textures[s_MaxTextureSlots][s_CachedTextureTargetCount];
+
+unsigned int GLStateCache::s_ActiveTextureSlot = s_Unknown;
+GLStateStats GLStateCache::s_FrameStats;
+GLStateStats GLStateCache::s_LastFrameStats;
+
+//Returns true if the bind needs to be issued, and remembers the new value
+static bool Track(unsigned int& cached, unsigned int value, GLStateStats& stats)
+{
+    if (cached == value)
+    {
+        stats.Skipped++;
+        return false;
+    }
+    cached = value;
+    stats.Issued++;
+    return true;
+}
+
+static int GetTextureTargetIndex(unsigned int target)
+{
+    for (unsigned int i = 0; i < s_CachedTextureTargetCount; i++)
+        if (s_CachedTextureTargets[i] == target)
+            return (int)i;
+    return -1;
+}
+
+void GLStateCache::UseProgram(unsigned int program)
+{
+    if (Track(s_Program, program, s_FrameStats))
+    {
+        GLCall(glUseProgram(program));
+        RenderStats::OnProgramBind();
+    }
+}
+
+void GLStateCache::BindVertexArray(unsigned int vao)
+{
+    if (Track(s_VertexArray, vao, s_FrameStats))
+    {
+        GLCall(glBindVertexArray(vao));
+        //Don't know which element buffer the new vertex array has
+        s_ElementBuffer = s_Unknown;
+    }
+}
+
+void GLStateCache::BindBuffer(unsigned int target, unsigned int buffer)
+{
+    unsigned int* cached = nullptr;
+    if (target == GL_ARRAY_BUFFER)
+        cached = &s_ArrayBuffer;
+    else if (target == GL_ELEMENT_ARRAY_BUFFER)
+        cached = &s_ElementBuffer;
+    
+    if (!cached)
+    {
+        s_FrameStats.Issued++;
+        GLCall(glBindBuffer(target, buffer));
+        return;
+    }
+    if (Track(*cached, buffer, s_FrameStats))
+    {
+        GLCall(glBindBuffer(target, buffer));
+    }
+}
+
+void GLStateCache::ActiveTexture(unsigned int slot)
+{
+    if (Track(s_ActiveTextureSlot, slot, s_FrameStats))
+    {
+        GLCall(glActiveTexture(GL_TEXTURE0 + slot));
+    }
+}
+
+void GLStateCache::BindTexture(unsigned int slot, unsigned int target, unsigned int texture)
+{
+    int targetIndex = GetTextureTargetIndex(target);
+    if (slot >= s_MaxTextureSlots || targetIndex < 0)
+    {
+        ActiveTexture(slot);
+        s_FrameStats.Issued++;
+        GLCall(glBindTexture(target, texture));
+        return;
+    }
+    
+    //Unit has to be active even when the bind is skipped, callers go on to change the texture through it
+    //(glTexImage2D, glTexParameteri etc. act on whatever is bound to the active unit)
+    ActiveTexture(slot);
+    if (s_Textures[slot][targetIndex] == texture)
+    {
+        s_FrameStats.Skipped++;
+        return;
+    }
+    Track(s_Textures[slot][targetIndex], texture, s_FrameStats);
+    GLCall(glBindTexture(target, texture));
+}
+
+void GLStateCache::OnProgramDeleted(unsigned int program)
+{
+    if (s_Program == program)
+        s_Program = s_Unknown;
+}
+
+void GLStateCache::OnVertexArrayDeleted(unsigned int vao)
+{
+    //Deleting the bound vertex array reverts to 0
+    if (s_VertexArray == vao)
+    {
+        s_VertexArray = 0;
+        s_ElementBuffer = s_Unknown;
+    }
+}
+
+void GLStateCache::OnBufferDeleted(unsigned int buffer)
+{
+    if (s_ArrayBuffer == buffer)
+        s_ArrayBuffer = 0;
+    if (s_ElementBuffer == buffer)
+        s_ElementBuffer = 0;
+}
+
+void GLStateCache::OnTextureDeleted(unsigned int texture)
+{
+    for (unsigned int slot = 0; slot < s_MaxTextureSlots; slot++)
+        for (unsigned int target = 0; target < s_CachedTextureTargetCount; target++)
+            if (s_Textures[slot][target] == texture)
+                s_Textures[slot][target] = 0;
+}
+
+void GLStateCache::Invalidate()
+{
+    s_Program = s_Unknown;
+    s_VertexArray = s_Unknown;
+    s_ArrayBuffer = s_Unknown;
+    s_ElementBuffer = s_Unknown;
+    s_ActiveTextureSlot = s_Unknown;
+    for (unsigned int slot = 0; slot < s_MaxTextureSlots; slot++)
+        for (unsigned int target = 0; target < s_CachedTextureTargetCount; target++)
+            s_Textures[slot][target] = s_Unknown;
+}
+
+void GLStateCache::BeginFrame()
+{
+    s_LastFrameStats = s_FrameStats;
+    s_FrameStats = GLStateStats();
+}
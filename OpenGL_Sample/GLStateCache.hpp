@@ -0,0 +1,56 @@
+//
+//  GLStateCache.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef GLStateCache_hpp
+#define GLStateCache_hpp
+
+struct GLStateStats
+{
+    //State changes that actually reached the driver
+    unsigned int Issued = 0;
+    //Binds that were skipped because the object was already bound
+    unsigned int Skipped = 0;
+};
+
+//CPU side copy of the GL bindings our wrapper classes care about
+//Every Bind in Shader, VertexArray, VertexBuffer, IndexBuffer and Texture goes through here
+//so that binding something that is already bound never reaches the driver
+//Only valid as long as nothing else changes these bindings behind its back, call Invalidate if something might have
+class GLStateCache
+{
+public:
+    static void UseProgram(unsigned int program);
+    static void BindVertexArray(unsigned int vao);
+    //GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER, other targets are passed straight through
+    static void BindBuffer(unsigned int target, unsigned int buffer);
+    //Makes slot the active texture unit and binds texture to target on it (each only if needed)
+    //Slot is always left active, so the texture can be changed through it straight after
+    static void BindTexture(unsigned int slot, unsigned int target, unsigned int texture);
+    static void ActiveTexture(unsigned int slot);
+    inline static unsigned int GetActiveTextureSlot() { return s_ActiveTextureSlot; }
+    
+    //GL unbinds objects when they are deleted and may hand the same name out again
+    //so the cache has to forget them too
+    static void OnProgramDeleted(unsigned int program);
+    static void OnVertexArrayDeleted(unsigned int vao);
+    static void OnBufferDeleted(unsigned int buffer);
+    static void OnTextureDeleted(unsigned int texture);
+    
+    //Forget everything, next bind of each kind is always issued
+    static void Invalidate();
+    
+    //Call once at the start of every frame, stats for the frame that just finished are kept around for display
+    static void BeginFrame();
+    inline static const GLStateStats& GetFrameStats() { return s_FrameStats; }
+    inline static const GLStateStats& GetLastFrameStats() { return s_LastFrameStats; }
+private:
+    static unsigned int s_ActiveTextureSlot;
+    static GLStateStats s_FrameStats;
+    static GLStateStats s_LastFrameStats;
+};
+
+#endif /* GLStateCache_hpp */
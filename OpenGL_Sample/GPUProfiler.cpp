@@ -0,0 +1,185 @@
+//
+//  GPUProfiler.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "GPUProfiler.hpp"
+#include "Renderer.h"
+
+#include <cstring>
+
+#include "imgui/imgui.h"
+
+namespace {
+
+    struct Scope
+    {
+        const char* Name;
+        unsigned int Depth;
+        //Indices into the frame's query list
+        unsigned int Begin, End;
+    };
+
+    //Everything recorded in one frame of the ring
+    struct Frame
+    {
+        //Query objects are kept and reused, Used is how many this frame has handed out so far
+        std::vector<unsigned int> Queries;
+        unsigned int Used = 0;
+        std::vector<Scope> Scopes;
+    };
+
+}
+
+static Frame s_Frames[GPUProfiler::FramesInFlight];
+static unsigned int s_Current = 0;
+//Scopes that have been begun but not ended yet in the current frame
+static std::vector<unsigned int> s_Open;
+
+static std::vector<GPUScopeResult> s_LastFrame;
+static std::map<std::string, GPUScopeTotal> s_Totals;
+static unsigned int s_TotalFrames = 0;
+
+static unsigned int NextQuery(Frame& frame)
+{
+    if (frame.Used == frame.Queries.size())
+    {
+        unsigned int query;
+        GLCall(glGenQueries(1, &query));
+        frame.Queries.push_back(query);
+    }
+    return frame.Used++;
+}
+
+//Reads back every finished scope of frame and merges scopes with the same name
+static void Resolve(Frame& frame)
+{
+    if (frame.Scopes.empty())
+        return;
+    
+    s_LastFrame.clear();
+    for (const Scope& scope : frame.Scopes)
+    {
+        //Never ended, e.g. an early return skipped EndScope
+        if (scope.End == scope.Begin)
+            continue;
+        
+        GLuint64 begin = 0, end = 0;
+        GLCall(glGetQueryObjectui64v(frame.Queries[scope.Begin], GL_QUERY_RESULT, &begin));
+        GLCall(glGetQueryObjectui64v(frame.Queries[scope.End], GL_QUERY_RESULT, &end));
+        float ms = (end - begin) / 1000000.0f;
+        
+        //Only a handful of distinct names per frame, so a linear search is fine
+        GPUScopeResult* result = nullptr;
+        for (GPUScopeResult& existing : s_LastFrame)
+        {
+            if (strcmp(existing.Name, scope.Name) == 0)
+            {
+                result = &existing;
+                break;
+            }
+        }
+        if (!result)
+        {
+            s_LastFrame.push_back({ scope.Name, scope.Depth, 0.0f, 0 });
+            result = &s_LastFrame.back();
+        }
+        result->Ms += ms;
+        result->Count++;
+    }
+    
+    for (const GPUScopeResult& result : s_LastFrame)
+    {
+        GPUScopeTotal& total = s_Totals[result.Name];
+        total.TotalMs += result.Ms;
+        total.Count += result.Count;
+    }
+    s_TotalFrames++;
+    
+    frame.Scopes.clear();
+    frame.Used = 0;
+}
+
+void GPUProfiler::BeginFrame()
+{
+    s_Open.clear();
+    s_Current = (s_Current + 1) % FramesInFlight;
+    //Oldest frame in the ring, recorded FramesInFlight - 1 frames ago
+    Resolve(s_Frames[s_Current]);
+}
+
+void GPUProfiler::BeginScope(const char* name)
+{
+    Frame& frame = s_Frames[s_Current];
+    unsigned int begin = NextQuery(frame);
+    GLCall(glQueryCounter(frame.Queries[begin], GL_TIMESTAMP));
+    //End == Begin marks it as still open
+    frame.Scopes.push_back({ name, (unsigned int)s_Open.size(), begin, begin });
+    s_Open.push_back((unsigned int)frame.Scopes.size() - 1);
+}
+
+void GPUProfiler::EndScope()
+{
+    if (s_Open.empty())
+        return;
+    
+    Frame& frame = s_Frames[s_Current];
+    unsigned int end = NextQuery(frame);
+    GLCall(glQueryCounter(frame.Queries[end], GL_TIMESTAMP));
+    frame.Scopes[s_Open.back()].End = end;
+    s_Open.pop_back();
+}
+
+void GPUProfiler::Flush()
+{
+    s_Open.clear();
+    //Oldest first so s_LastFrame ends up being the current frame
+    for (unsigned int i = 1; i <= FramesInFlight; i++)
+        Resolve(s_Frames[(s_Current + i) % FramesInFlight]);
+}
+
+void GPUProfiler::Shutdown()
+{
+    for (Frame& frame : s_Frames)
+    {
+        if (!frame.Queries.empty())
+        {
+            GLCall(glDeleteQueries((GLsizei)frame.Queries.size(), frame.Queries.data()));
+        }
+        frame = Frame();
+    }
+    s_Open.clear();
+    s_LastFrame.clear();
+}
+
+const std::vector<GPUScopeResult>& GPUProfiler::GetLastFrame()
+{
+    return s_LastFrame;
+}
+
+void GPUProfiler::ResetTotals()
+{
+    s_Totals.clear();
+    s_TotalFrames = 0;
+}
+
+const std::map<std::string, GPUScopeTotal>& GPUProfiler::GetTotals()
+{
+    return s_Totals;
+}
+
+unsigned int GPUProfiler::GetTotalFrames()
+{
+    return s_TotalFrames;
+}
+
+void GPUProfiler::OnImGuiRender()
+{
+    ImGui::Begin("GPU Timings");
+    ImGui::Text("%u frames behind", FramesInFlight - 1);
+    for (const GPUScopeResult& result : s_LastFrame)
+        ImGui::Text("%*s%s: %.3f ms (x%u)", result.Depth * 2, "", result.Name, result.Ms, result.Count);
+    ImGui::End();
+}
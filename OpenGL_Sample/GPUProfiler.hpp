@@ -0,0 +1,77 @@
+//
+//  GPUProfiler.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef GPUProfiler_hpp
+#define GPUProfiler_hpp
+
+#include <map>
+#include <string>
+#include <vector>
+
+//GPU time of one named scope over a frame, every scope with the same name is added together
+struct GPUScopeResult
+{
+    //Whatever was passed to BeginScope, has to be a string literal (or live as long as the profiler)
+    const char* Name;
+    //How many scopes it was nested in the first time it showed up, used to indent the overlay
+    unsigned int Depth;
+    float Ms;
+    unsigned int Count;
+};
+
+//Running totals since the last ResetTotals, used by the benchmark to get per frame averages
+struct GPUScopeTotal
+{
+    float TotalMs = 0.0f;
+    unsigned int Count = 0;
+};
+
+//Measures how long the GPU spends on scopes of work using glQueryCounter(GL_TIMESTAMP) pairs
+//Timestamps instead of GL_TIME_ELAPSED so scopes can nest (only one TIME_ELAPSED query can be active at a time)
+//Queries are recycled through a ring of FramesInFlight frames, so results are read back that many frames late
+//by which point the GPU is long done with them and reading them never stalls
+class GPUProfiler
+{
+public:
+    static const unsigned int FramesInFlight = 4;
+    
+    //Call once at the start of every frame, reads back the oldest frame in the ring before reusing its queries
+    static void BeginFrame();
+    static void BeginScope(const char* name);
+    static void EndScope();
+    
+    //Waits for every frame still in flight and reads it back, e.g. before reading the totals
+    static void Flush();
+    //Deletes all the query objects, call before the context goes away
+    static void Shutdown();
+    
+    //Scopes of the most recent frame that has been read back
+    static const std::vector<GPUScopeResult>& GetLastFrame();
+    
+    static void ResetTotals();
+    static const std::map<std::string, GPUScopeTotal>& GetTotals();
+    //Frames read back since the last ResetTotals
+    static unsigned int GetTotalFrames();
+    
+    //ImGui window listing the last frame's scopes
+    static void OnImGuiRender();
+};
+
+//Times everything until the end of the enclosing block
+class GPUProfileScope
+{
+public:
+    GPUProfileScope(const char* name) { GPUProfiler::BeginScope(name); }
+    ~GPUProfileScope() { GPUProfiler::EndScope(); }
+};
+
+//Two levels so __LINE__ gets expanded before it's pasted onto the variable name
+#define GPU_PROFILE_CONCAT_INNER(a, b) a##b
+#define GPU_PROFILE_CONCAT(a, b) GPU_PROFILE_CONCAT_INNER(a, b)
+#define GPU_PROFILE_SCOPE(name) GPUProfileScope GPU_PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
+
+#endif /* GPUProfiler_hpp */
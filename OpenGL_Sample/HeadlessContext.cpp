@@ -0,0 +1,152 @@
+//
+//  HeadlessContext.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "HeadlessContext.hpp"
+#include "Renderer.h"
+
+#include <iostream>
+
+#ifdef __APPLE__
+
+#include "glfw3.h"
+
+HeadlessContext::HeadlessContext()
+    : m_Window(nullptr), m_Valid(false)
+{
+    if (!glfwInit())
+        return;
+    
+    //Same context as the windowed app gets
+    glfwWindowHint( GLFW_CONTEXT_VERSION_MAJOR, 3 );
+    glfwWindowHint( GLFW_CONTEXT_VERSION_MINOR, 3 );
+    glfwWindowHint( GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE );
+    glfwWindowHint( GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE );
+#if GL_ERROR_POLICY == GL_ERROR_POLICY_DEBUG_OUTPUT
+    glfwWindowHint( GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE );
+#endif
+    //Never shown, it's only here because macOS needs a window to hang a context off
+    glfwWindowHint( GLFW_VISIBLE, GLFW_FALSE );
+    
+    m_Window = glfwCreateWindow(64, 64, "Headless", NULL, NULL);
+    if (!m_Window)
+    {
+        std::cout << "Failed to create hidden window for headless context" << std::endl;
+        glfwTerminate();
+        return;
+    }
+    glfwMakeContextCurrent(m_Window);
+    //We never swap, but just in case something does it shouldn't wait for vsync
+    glfwSwapInterval(0);
+    m_Valid = true;
+}
+
+HeadlessContext::~HeadlessContext()
+{
+    if (m_Window)
+    {
+        glfwDestroyWindow(m_Window);
+        glfwTerminate();
+    }
+}
+
+#else
+
+//A GLEW built for GLX looks its entry points up with glXGetProcAddress, and glewInit fails outright without an X display.
+//On a surfaceless EGL context it has to be the GLEW_EGL build, which goes through eglGetProcAddress instead
+#ifndef GLEW_EGL
+#error "The EGL headless context needs GLEW built and compiled with GLEW_EGL defined"
+#endif
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+//Older eglext.h headers don't have the Mesa surfaceless platform yet
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+HeadlessContext::HeadlessContext()
+    : m_Display(EGL_NO_DISPLAY), m_Surface(EGL_NO_SURFACE), m_Context(EGL_NO_CONTEXT), m_Valid(false)
+{
+    //Surfaceless doesn't need an X server or a GPU, which is exactly what build machines don't have
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    EGLDisplay display = EGL_NO_DISPLAY;
+    if (getPlatformDisplay)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+    {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+        {
+            std::cout << "Failed to initialize an EGL display for headless context" << std::endl;
+            return;
+        }
+    }
+    m_Display = display;
+    
+    //Desktop GL, not GLES
+    eglBindAPI(EGL_OPENGL_API);
+    
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0)
+    {
+        std::cout << "No EGL config with pbuffer and OpenGL support" << std::endl;
+        return;
+    }
+    
+    //Tiny pbuffer just so we have something to make current, all the real drawing goes into a Framebuffer
+    const EGLint surfaceAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+    m_Surface = eglCreatePbufferSurface(display, config, surfaceAttribs);
+    
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+#if GL_ERROR_POLICY == GL_ERROR_POLICY_DEBUG_OUTPUT
+        EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE,
+#endif
+        EGL_NONE
+    };
+    m_Context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (m_Context == EGL_NO_CONTEXT)
+    {
+        std::cout << "Failed to create EGL OpenGL 3.3 core context, error 0x" << std::hex << eglGetError() << std::dec << std::endl;
+        return;
+    }
+    
+    //Some drivers won't give us a pbuffer, surfaceless is fine too since we draw into a Framebuffer anyway
+    if (!eglMakeCurrent(display, m_Surface, m_Surface, m_Context))
+    {
+        std::cout << "Failed to make headless context current" << std::endl;
+        return;
+    }
+    //Nothing is ever presented, but make sure a swap wouldn't wait on vsync either
+    eglSwapInterval(display, 0);
+    m_Valid = true;
+}
+
+HeadlessContext::~HeadlessContext()
+{
+    if (m_Display == EGL_NO_DISPLAY)
+        return;
+    
+    eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_Context != EGL_NO_CONTEXT)
+        eglDestroyContext(m_Display, m_Context);
+    if (m_Surface != EGL_NO_SURFACE)
+        eglDestroySurface(m_Display, m_Surface);
+    eglTerminate(m_Display);
+}
+
+#endif
@@ -0,0 +1,42 @@
+//
+//  HeadlessContext.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef HeadlessContext_hpp
+#define HeadlessContext_hpp
+
+#ifdef __APPLE__
+struct GLFWwindow;
+#endif
+
+//An OpenGL 3.3 core context with nothing on screen, for running tests on machines without a display
+//  Linux: EGL on Mesa's surfaceless platform (works with llvmpipe on CPU only machines),
+//         falling back to the default EGL display if surfaceless isn't there.
+//         Needs GLEW built with GLEW_EGL (and GLEW_EGL defined here too), link against libEGL
+//  macOS: no EGL, so a hidden GLFW window stands in
+//Either way there's no usable default framebuffer, so draw into a Framebuffer
+//Nothing is ever presented, so there's no vsync holding the frame rate back
+class HeadlessContext
+{
+private:
+#ifdef __APPLE__
+    GLFWwindow* m_Window;
+#else
+    //EGLDisplay, EGLSurface and EGLContext, kept as void* so egl.h stays out of this header
+    void* m_Display;
+    void* m_Surface;
+    void* m_Context;
+#endif
+    bool m_Valid;
+public:
+    //Makes the context current, check IsValid afterwards. glewInit still needs to be called
+    HeadlessContext();
+    ~HeadlessContext();
+    
+    inline bool IsValid() const { return m_Valid; }
+};
+
+#endif /* HeadlessContext_hpp */
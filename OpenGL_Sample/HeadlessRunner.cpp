@@ -0,0 +1,118 @@
+//
+//  HeadlessRunner.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "HeadlessRunner.hpp"
+#include "CPUProfiler.hpp"
+#include "Renderer.h"
+#include "GLStateCache.hpp"
+#include "GPUProfiler.hpp"
+#include "RenderStats.hpp"
+#include "TextureResidency.hpp"
+#include "ShaderBuildQueue.hpp"
+#include "TextureLoader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+
+float FrameTimings::GetAverageDrawCalls() const
+{
+    return DrawCalls.empty() ? 0.0f : std::accumulate(DrawCalls.begin(), DrawCalls.end(), 0.0f) / DrawCalls.size();
+}
+
+float FrameTimings::GetPercentile(const std::vector<float>& values, float percentile)
+{
+    if (values.empty())
+        return 0.0f;
+    
+    std::vector<float> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    size_t rank = (size_t)std::ceil(percentile / 100.0f * sorted.size());
+    return sorted[std::min(std::max(rank, (size_t)1), sorted.size()) - 1];
+}
+
+HeadlessRunner::HeadlessRunner(int width, int height)
+    : m_TimerQuery(0)
+{
+    m_Framebuffer = std::make_unique<Framebuffer>(width, height);
+    //Timer queries are core since 3.3 so this is always there
+    GLCall(glGenQueries(1, &m_TimerQuery));
+}
+
+HeadlessRunner::~HeadlessRunner()
+{
+    GLCall(glDeleteQueries(1, &m_TimerQuery));
+}
+
+FrameTimings HeadlessRunner::Run(test::Test& test, unsigned int frameCount)
+{
+    FrameTimings timings;
+    timings.FrameMs.reserve(frameCount);
+    timings.GpuMs.reserve(frameCount);
+    timings.DrawCalls.reserve(frameCount);
+    
+    //Anything still in flight belongs to whatever ran before us
+    GPUProfiler::Flush();
+    GPUProfiler::ResetTotals();
+    
+    m_Framebuffer->Bind();
+    float deltaTime = 0.0f;
+    for (unsigned int frame = 0; frame < frameCount; frame++)
+    {
+        CPU_PROFILE_SCOPE("Frame");
+        auto start = std::chrono::steady_clock::now();
+        GLCall(glBeginQuery(GL_TIME_ELAPSED, m_TimerQuery));
+        
+        GLStateCache::BeginFrame();
+        GLStateCache::Invalidate();
+        GPUProfiler::BeginFrame();
+        RenderStats::BeginFrame();
+        TextureResidency::BeginFrame();
+        
+        GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+        GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+        
+        TextureLoader::Get().Update();
+        ShaderBuildQueue::Get().Update();
+        
+        {
+            CPU_PROFILE_SCOPE("Test::OnUpdate");
+            test.OnUpdate(deltaTime);
+        }
+        {
+            CPU_PROFILE_SCOPE("Test::OnRender");
+            GPU_PROFILE_SCOPE("Test::OnRender");
+            test.OnRender();
+        }
+        
+        GLCall(glEndQuery(GL_TIME_ELAPSED));
+        GLCheckFrameErrors();
+        //Stands in for the swap, wait for the GPU so the frame is really done
+        GLCall(glFinish());
+        
+        float frameMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        timings.FrameMs.push_back(frameMs);
+        timings.DrawCalls.push_back(RenderStats::GetFrameStats().DrawCalls);
+        deltaTime = frameMs / 1000.0f;
+        
+        //Already finished so reading it back doesn't stall, and it's outside the timed part anyway
+        GLuint64 gpuNs = 0;
+        GLCall(glGetQueryObjectui64v(m_TimerQuery, GL_QUERY_RESULT, &gpuNs));
+        timings.GpuMs.push_back(gpuNs / 1000000.0f);
+    }
+    m_Framebuffer->Unbind();
+    
+    GPUProfiler::Flush();
+    if (unsigned int frames = GPUProfiler::GetTotalFrames())
+    {
+        for (auto& total : GPUProfiler::GetTotals())
+            timings.GpuScopeMs[total.first] = total.second.TotalMs / frames;
+    }
+    
+    return timings;
+}
@@ -0,0 +1,54 @@
+//
+//  HeadlessRunner.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef HeadlessRunner_hpp
+#define HeadlessRunner_hpp
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Framebuffer.hpp"
+#include "tests/Test.hpp"
+
+struct FrameTimings
+{
+    //Wall clock time of every frame in milliseconds, in the order they ran
+    std::vector<float> FrameMs;
+    //GPU time of every frame from a GL_TIME_ELAPSED query, same order
+    std::vector<float> GpuMs;
+    //Renderer draw calls issued in every frame
+    std::vector<unsigned int> DrawCalls;
+    //Average GPU time per frame of every GPUProfiler scope that ran
+    std::map<std::string, float> GpuScopeMs;
+    
+    float GetAverageDrawCalls() const;
+    
+    //percentile is 0 to 100, nearest rank so the result is always a frame that actually happened
+    static float GetPercentile(const std::vector<float>& values, float percentile);
+};
+
+//Runs tests for a fixed number of frames into an offscreen Framebuffer and times each frame
+//Needs a current context (normally a HeadlessContext), ImGui isn't touched so it doesn't need to be set up
+class HeadlessRunner
+{
+private:
+    std::unique_ptr<Framebuffer> m_Framebuffer;
+    unsigned int m_TimerQuery;
+public:
+    HeadlessRunner(int width = 960, int height = 540);
+    ~HeadlessRunner();
+    
+    //Does the same per frame work as the main loop minus ImGui and swapping
+    //Each frame ends with glFinish so the time includes the GPU actually drawing it, not just queueing commands
+    FrameTimings Run(test::Test& test, unsigned int frameCount);
+    
+    inline const Framebuffer& GetFramebuffer() const { return *m_Framebuffer; }
+};
+
+#endif /* HeadlessRunner_hpp */
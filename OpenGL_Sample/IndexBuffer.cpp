@@ -7,30 +7,38 @@
 
 #include "IndexBuffer.hpp"
 #include "Renderer.h"
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
 
 
 IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count):
     m_Count(count)
 {
     GLCall(glGenBuffers(1, &m_RendererID));
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+    Bind();
     //May be some danger here because assuming size of an unsigned int is the same as GLuint
     //Cherno never seen an unsigned int not be 4 bytes, but could be different on different platforms
     //Could assert if really concerned
     GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));
+    RenderStats::OnObjectCreated(GLObjectType::IndexBuffer);
+    RenderStats::OnMemoryAllocated(GLObjectType::IndexBuffer, count * sizeof(unsigned int));
+    RenderStats::OnBufferUpload(count * sizeof(unsigned int));
 }
 
 IndexBuffer::~IndexBuffer()
 {
     GLCall(glDeleteBuffers(1, &m_RendererID));
+    GLStateCache::OnBufferDeleted(m_RendererID);
+    RenderStats::OnObjectDestroyed(GLObjectType::IndexBuffer);
+    RenderStats::OnMemoryFreed(GLObjectType::IndexBuffer, m_Count * sizeof(unsigned int));
 }
 
 void IndexBuffer::Bind() const
 {
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 }
 
 void IndexBuffer::Unbind() const
 {
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
@@ -0,0 +1,138 @@
+//
+//  RenderStats.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "RenderStats.hpp"
+
+#include "imgui/imgui.h"
+
+RenderFrameStats RenderStats::s_FrameStats;
+RenderFrameStats RenderStats::s_LastFrameStats;
+
+static unsigned int s_Alive[(int)GLObjectType::Count] = {};
+static unsigned long long s_Memory[(int)GLObjectType::Count] = {};
+
+void RenderStats::OnDrawCall(unsigned int indexCount, unsigned int instanceCount)
+{
+    s_FrameStats.DrawCalls++;
+    s_FrameStats.Indices += indexCount * instanceCount;
+}
+
+void RenderStats::OnShaderBind()
+{
+    s_FrameStats.ShaderBinds++;
+}
+
+void RenderStats::OnProgramBind()
+{
+    s_FrameStats.ProgramBinds++;
+}
+
+void RenderStats::OnTextureBind()
+{
+    s_FrameStats.TextureBinds++;
+}
+
+void RenderStats::OnUniformUpload()
+{
+    s_FrameStats.UniformUploads++;
+}
+
+void RenderStats::OnBufferUpload(unsigned long long bytes)
+{
+    s_FrameStats.BufferBytesUploaded += bytes;
+}
+
+void RenderStats::OnTextureUpload(unsigned long long bytes)
+{
+    s_FrameStats.TextureBytesUploaded += bytes;
+}
+
+void RenderStats::OnObjectCreated(GLObjectType type)
+{
+    s_Alive[(int)type]++;
+}
+
+void RenderStats::OnObjectDestroyed(GLObjectType type)
+{
+    s_Alive[(int)type]--;
+}
+
+void RenderStats::OnMemoryAllocated(GLObjectType type, unsigned long long bytes)
+{
+    s_Memory[(int)type] += bytes;
+}
+
+void RenderStats::OnMemoryFreed(GLObjectType type, unsigned long long bytes)
+{
+    s_Memory[(int)type] -= bytes;
+}
+
+void RenderStats::BeginFrame()
+{
+    s_LastFrameStats = s_FrameStats;
+    s_FrameStats = RenderFrameStats();
+}
+
+unsigned int RenderStats::GetAliveCount(GLObjectType type)
+{
+    return s_Alive[(int)type];
+}
+
+unsigned long long RenderStats::GetMemoryUsed(GLObjectType type)
+{
+    return s_Memory[(int)type];
+}
+
+unsigned long long RenderStats::GetTotalMemoryUsed()
+{
+    unsigned long long total = 0;
+    for (int i = 0; i < (int)GLObjectType::Count; i++)
+        total += s_Memory[i];
+    return total;
+}
+
+const char* RenderStats::GetObjectTypeName(GLObjectType type)
+{
+    switch (type)
+    {
+        case GLObjectType::VertexBuffer: return "VertexBuffer";
+        case GLObjectType::IndexBuffer: return "IndexBuffer";
+        case GLObjectType::VertexArray: return "VertexArray";
+        case GLObjectType::Texture: return "Texture";
+        case GLObjectType::Shader: return "Shader";
+        default: return "Unknown";
+    }
+}
+
+void RenderStats::OnImGuiRender()
+{
+    if (!ImGui::CollapsingHeader("Render Stats", ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+    
+    const RenderFrameStats& stats = s_LastFrameStats;
+    ImGui::Text("Draw calls: %u (%u indices)", stats.DrawCalls, stats.Indices);
+    ImGui::Text("Shader binds: %u (%u reached the driver)", stats.ShaderBinds, stats.ProgramBinds);
+    ImGui::Text("Texture binds: %u", stats.TextureBinds);
+    ImGui::Text("Uniform uploads: %u", stats.UniformUploads);
+    ImGui::Text("Uploaded: %.1f KB buffers, %.1f KB textures", stats.BufferBytesUploaded / 1024.0f, stats.TextureBytesUploaded / 1024.0f);
+    
+    ImGui::Text("Alive:");
+    for (int i = 0; i < (int)GLObjectType::Count; i++)
+    {
+        ImGui::SameLine();
+        ImGui::Text("%s %u", GetObjectTypeName((GLObjectType)i), s_Alive[i]);
+    }
+    
+    ImGui::Text("GPU memory: %.1f MB", GetTotalMemoryUsed() / (1024.0f * 1024.0f));
+    for (int i = 0; i < (int)GLObjectType::Count; i++)
+    {
+        if (!s_Memory[i])
+            continue;
+        ImGui::SameLine();
+        ImGui::Text("%s %.1f MB", GetObjectTypeName((GLObjectType)i), s_Memory[i] / (1024.0f * 1024.0f));
+    }
+}
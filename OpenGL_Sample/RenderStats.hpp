@@ -0,0 +1,73 @@
+//
+//  RenderStats.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef RenderStats_hpp
+#define RenderStats_hpp
+
+//Everything the wrapper classes and Renderer did in one frame
+struct RenderFrameStats
+{
+    unsigned int DrawCalls = 0;
+    //Indices across all draw calls, multiplied by the instance count for instanced draws
+    unsigned int Indices = 0;
+    //Shader::Bind calls, most of which GLStateCache will skip
+    unsigned int ShaderBinds = 0;
+    //glUseProgram calls that actually reached the driver
+    unsigned int ProgramBinds = 0;
+    unsigned int TextureBinds = 0;
+    unsigned int UniformUploads = 0;
+    //Vertex, index and pixel buffer data sent to the GPU
+    unsigned long long BufferBytesUploaded = 0;
+    //Pixels straight from memory, uploads that went through a pixel buffer are counted in BufferBytesUploaded
+    unsigned long long TextureBytesUploaded = 0;
+};
+
+//Wrapper classes whose live instances (and, for buffers and textures, GPU memory) are counted
+enum class GLObjectType
+{
+    VertexBuffer, IndexBuffer, VertexArray, Texture, Shader, Count
+};
+
+//Per frame counters, collected by the wrapper classes and Renderer as they make GL calls
+//Same BeginFrame pattern as GLStateCache, the last finished frame is kept around for display
+class RenderStats
+{
+public:
+    static void OnDrawCall(unsigned int indexCount, unsigned int instanceCount = 1);
+    static void OnShaderBind();
+    static void OnProgramBind();
+    static void OnTextureBind();
+    static void OnUniformUpload();
+    static void OnBufferUpload(unsigned long long bytes);
+    static void OnTextureUpload(unsigned long long bytes);
+    
+    static void OnObjectCreated(GLObjectType type);
+    static void OnObjectDestroyed(GLObjectType type);
+    //Storage the driver holds for an object, worked out from its size and format (the driver may round it up a bit)
+    static void OnMemoryAllocated(GLObjectType type, unsigned long long bytes);
+    static void OnMemoryFreed(GLObjectType type, unsigned long long bytes);
+    
+    //Call once at the start of every frame
+    static void BeginFrame();
+    //Frame in progress
+    inline static const RenderFrameStats& GetFrameStats() { return s_FrameStats; }
+    //Last finished frame, what the UI should show
+    inline static const RenderFrameStats& GetLastFrameStats() { return s_LastFrameStats; }
+    
+    static unsigned int GetAliveCount(GLObjectType type);
+    static unsigned long long GetMemoryUsed(GLObjectType type);
+    static unsigned long long GetTotalMemoryUsed();
+    static const char* GetObjectTypeName(GLObjectType type);
+    
+    //Collapsible section for whatever ImGui window is current
+    static void OnImGuiRender();
+private:
+    static RenderFrameStats s_FrameStats;
+    static RenderFrameStats s_LastFrameStats;
+};
+
+#endif /* RenderStats_hpp */
@@ -6,6 +6,9 @@
 //
 
 #include "Renderer.h"
+#include "CPUProfiler.hpp"
+#include "GPUProfiler.hpp"
+#include "RenderStats.hpp"
 
 #include <iostream>
 
@@ -26,8 +29,83 @@ bool GLLogCall(const char* function, const char* file, int line)
     return true;
 }
 
+#if GL_ERROR_POLICY == GL_ERROR_POLICY_DEBUG_OUTPUT
+//Call site of the GLCall currently running
+static const char* s_CallFunction = "";
+static const char* s_CallFile = "";
+static int s_CallLine = 0;
+//Set by the debug callback, reset by every GLBeginCall
+static bool s_CallFailed = false;
+//False until GLInitErrorPolicy manages to install the callback, GLCall does per call checks until then
+static bool s_DebugOutputActive = false;
+
+static void GLAPIENTRY GLDebugMessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei /*length*/, const GLchar* message, const void* /*userParam*/)
+{
+    //Notifications are things like "buffer will use video memory", far too chatty
+    if (severity == GL_DEBUG_SEVERITY_NOTIFICATION)
+        return;
+    //Some drivers (Mesa) report bad GLSL here as an error, but a shader that doesn't compile isn't a misused call
+    //Whoever compiled it checks the status and prints the info log, which hot reload relies on to keep going
+    if (source == GL_DEBUG_SOURCE_SHADER_COMPILER)
+        return;
+    
+    std::cout << "[OpenGL Debug] (" << id << ") " << message << std::endl;
+    std::cout << "    " << s_CallFunction << " " << s_CallFile << ":" << s_CallLine << std::endl;
+    if (type == GL_DEBUG_TYPE_ERROR)
+        s_CallFailed = true;
+}
+
+void GLBeginCall(const char* function, const char* file, int line)
+{
+    s_CallFunction = function;
+    s_CallFile = file;
+    s_CallLine = line;
+    s_CallFailed = false;
+    if (!s_DebugOutputActive)
+        GLClearError();
+}
+
+bool GLEndCall()
+{
+    if (!s_DebugOutputActive)
+        return GLLogCall(s_CallFunction, s_CallFile, s_CallLine);
+    //Synchronous debug output means the callback has already run by now
+    return !s_CallFailed;
+}
+#endif
+
+void GLInitErrorPolicy()
+{
+#if GL_ERROR_POLICY == GL_ERROR_POLICY_DEBUG_OUTPUT
+    if (!GLEW_KHR_debug)
+    {
+        std::cout << "KHR_debug not supported, checking glGetError after every GLCall instead" << std::endl;
+        return;
+    }
+    glEnable(GL_DEBUG_OUTPUT);
+    //Callback runs inside the GL call that caused the message, so the call site above is still correct
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(GLDebugMessageCallback, nullptr);
+    s_DebugOutputActive = true;
+#endif
+}
+
+void GLCheckFrameErrors()
+{
+#if GL_ERROR_POLICY == GL_ERROR_POLICY_SAMPLED
+    static unsigned long long frame = 0;
+    frame++;
+    //One round trip per frame instead of two per call
+    //Doesn't tell us which call failed, switch to PER_CALL or DEBUG_OUTPUT to track it down
+    while(GLenum error = glGetError())
+        std::cout << "[OpenGL Error] (" << error << ") during frame " << frame << std::endl;
+#endif
+}
+
 void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const
 {
+    CPU_PROFILE_SCOPE("Renderer::Draw");
+    GPU_PROFILE_SCOPE("Renderer::Draw");
     //Binds a program for our GPU to actually use to render
     shader.Bind();
     //Array that contains all of the actual data
@@ -39,6 +117,53 @@ void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader&
     //Element buffer is synonymous with index buffer
     //Could theoretically put into IndexBuffer class, but for our implementation, we'll leave that up to the Renderer
     GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
+    RenderStats::OnDrawCall(ib.GetCount());
+}
+
+void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count) const
+{
+    CPU_PROFILE_SCOPE("Renderer::Draw");
+    GPU_PROFILE_SCOPE("Renderer::Draw");
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    GLCall(glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr));
+    RenderStats::OnDrawCall(count);
+}
+
+void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count, int baseVertex) const
+{
+    CPU_PROFILE_SCOPE("Renderer::Draw");
+    GPU_PROFILE_SCOPE("Renderer::Draw");
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, baseVertex));
+    RenderStats::OnDrawCall(count);
+}
+
+void Renderer::Draw(const VertexArray& va, const StreamingBuffer& indices, unsigned int indexOffset, unsigned int count, const Shader& shader, int baseVertex) const
+{
+    CPU_PROFILE_SCOPE("Renderer::Draw");
+    GPU_PROFILE_SCOPE("Renderer::Draw");
+    shader.Bind();
+    va.Bind();
+    //Element buffer binding belongs to the vertex array, so this has to come after va.Bind
+    indices.Bind();
+    GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, (const void*)(size_t)indexOffset, baseVertex));
+    RenderStats::OnDrawCall(count);
+}
+
+void Renderer::DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const
+{
+    CPU_PROFILE_SCOPE("Renderer::DrawInstanced");
+    GPU_PROFILE_SCOPE("Renderer::DrawInstanced");
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+    //gl_InstanceID goes from 0 to instanceCount - 1 in the vertex shader
+    GLCall(glDrawElementsInstanced(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr, instanceCount));
+    RenderStats::OnDrawCall(ib.GetCount(), instanceCount);
 }
 
 void Renderer::Clear() const
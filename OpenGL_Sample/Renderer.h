@@ -22,24 +22,73 @@ class Shader;
 //For example, for MSVC you call __debugbreak() isntead of __builtin_trap()
 #define ASSERT(x) if(!(x)) __builtin_trap();
 
+//How GLCall checks for errors, pick one at build time by defining GL_ERROR_POLICY
+//  OFF          GLCall(x) is just x, no checking at all
+//  SAMPLED      GLCall(x) is just x, GLCheckFrameErrors drains glGetError once per frame (no file/line, but no stalls)
+//  PER_CALL     glGetError before and after every call, original behaviour
+//  DEBUG_OUTPUT KHR_debug callback reports errors with the file/line of the GLCall that caused them
+//               Falls back to PER_CALL at runtime if the driver doesn't have KHR_debug (e.g. macOS, which stops at 4.1)
+#define GL_ERROR_POLICY_OFF          0
+#define GL_ERROR_POLICY_SAMPLED      1
+#define GL_ERROR_POLICY_PER_CALL     2
+#define GL_ERROR_POLICY_DEBUG_OUTPUT 3
+
+#ifndef GL_ERROR_POLICY
+    #ifdef DEBUG
+        #define GL_ERROR_POLICY GL_ERROR_POLICY_DEBUG_OUTPUT
+    #else
+        #define GL_ERROR_POLICY GL_ERROR_POLICY_SAMPLED
+    #endif
+#endif
+
 //Use this macro to wrap OpenGL function calls
 //Avoids having to clear errors and check/log errors after every OpenGL function
 //A few flaws with this
 //  1. If we use a one line if statement this won't work, can fix by surrounding in scope (though not preferable)
 //      See macros video for more info
-#define GLCall(x) GLClearError();\
-    x;\
-    ASSERT(GLLogCall(#x, __FILE__, __LINE__))
+#if GL_ERROR_POLICY == GL_ERROR_POLICY_PER_CALL
+    #define GLCall(x) GLClearError();\
+        x;\
+        ASSERT(GLLogCall(#x, __FILE__, __LINE__))
+#elif GL_ERROR_POLICY == GL_ERROR_POLICY_DEBUG_OUTPUT
+    //Just remembers where we are so the debug callback can say which call it's complaining about
+    #define GLCall(x) GLBeginCall(#x, __FILE__, __LINE__);\
+        x;\
+        ASSERT(GLEndCall())
+#else
+    #define GLCall(x) x;
+#endif
 
 void GLClearError();
 
 bool GLLogCall(const char* function, const char* file, int line);
 
+//Needs a current context, call once right after glewInit
+//Hooks up the debug callback when GL_ERROR_POLICY is DEBUG_OUTPUT
+void GLInitErrorPolicy();
+
+//Call once per frame, only does anything for the SAMPLED policy
+void GLCheckFrameErrors();
+
+#if GL_ERROR_POLICY == GL_ERROR_POLICY_DEBUG_OUTPUT
+void GLBeginCall(const char* function, const char* file, int line);
+//Returns false if the call that just ran raised an error
+bool GLEndCall();
+#endif
+
 class Renderer
 {
 public:
     void Clear() const;
     void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
+    //Only draws the first count indices of ib
+    void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count) const;
+    //baseVertex is added to every index, used to draw vertices that were written into the middle of a StreamingBuffer
+    void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count, int baseVertex) const;
+    //Indices come from a StreamingBuffer created for GL_ELEMENT_ARRAY_BUFFER, indexOffset is the byte offset Write returned
+    void Draw(const VertexArray& va, const StreamingBuffer& indices, unsigned int indexOffset, unsigned int count, const Shader& shader, int baseVertex = 0) const;
+    //Draws ib instanceCount times in one call, per instance attributes come from buffers with a divisor set in their layout
+    void DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const;
 };
 
 #endif /* Renderer_h */
@@ -6,177 +6,274 @@
 //
 
 #include "Shader.hpp"
+#include "CPUProfiler.hpp"
+#include "GLStateCache.hpp"
+#include "ShaderBuildQueue.hpp"
+#include "ShaderParser.hpp"
+#include "ShaderWatcher.hpp"
+#include "UniformBuffer.hpp"
+#include "RenderStats.hpp"
 
+#include <algorithm>
 #include <iostream>
-#include <fstream>
 #include <string>
-#include <sstream>
 
-Shader::Shader(const std::string& filepath)
-: m_Filepath(filepath), m_RendererID(0)
+Shader::Shader(const std::string& filepath, const std::vector<std::string>& defines)
+: m_Filepath(filepath), m_RendererID(0), m_Defines(defines), m_BuildQueue(nullptr), m_BuildId(0)
 {
-    //Xcode really isn't setup for relative paths
-    ShaderProgramSouce source = ParseShader(filepath);
-    m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+    CPU_PROFILE_FUNCTION();
+    //Same path as the queued constructor, just with a queue of one that we wait on right away
+    ShaderBuildQueue queue;
+    SubmitBuild(queue);
+    queue.Finish();
+    ShaderWatcher::Get().Watch(*this);
+    RenderStats::OnObjectCreated(GLObjectType::Shader);
+}
+
+Shader::Shader(const std::string& filepath, ShaderBuildQueue& queue, const std::vector<std::string>& defines)
+: m_Filepath(filepath), m_RendererID(0), m_Defines(defines), m_BuildQueue(nullptr), m_BuildId(0)
+{
+    CPU_PROFILE_FUNCTION();
+    SubmitBuild(queue);
+    ShaderWatcher::Get().Watch(*this);
+    RenderStats::OnObjectCreated(GLObjectType::Shader);
 }
+
 Shader::~Shader()
 {
-    GLCall(glDeleteProgram(m_RendererID));
+    ShaderWatcher::Get().Unwatch(*this);
+    if (m_BuildQueue)
+        m_BuildQueue->Cancel(m_BuildId);
+    if (m_RendererID)
+    {
+        GLCall(glDeleteProgram(m_RendererID));
+        GLStateCache::OnProgramDeleted(m_RendererID);
+    }
+    RenderStats::OnObjectDestroyed(GLObjectType::Shader);
+}
+
+void Shader::SubmitBuild(ShaderBuildQueue& queue)
+{
+    //Xcode really isn't setup for relative paths
+    ShaderProgramSouce source = InjectDefines(ParseShader(m_Filepath), m_Defines);
+    m_BuildQueue = &queue;
+    m_BuildId = queue.Submit(m_Filepath, source, [this](unsigned int program)
+    {
+        m_BuildQueue = nullptr;
+        m_BuildId = 0;
+        //Failed builds have already printed their log, the shader just never becomes ready
+        if (program)
+            ReplaceProgram(program);
+    });
 }
 
 ShaderProgramSouce Shader::ParseShader(const std::string& filepath)
 {
-    //Opens file
-    std::ifstream stream(filepath);
+    return ShaderParser::Parse(filepath);
+}
+
+static void InsertDefines(std::string& stage, const std::string& defines)
+{
+    size_t version = stage.find("#version");
+    size_t insert = 0;
+    if (version != std::string::npos)
+    {
+        insert = stage.find('\n', version);
+        insert = insert == std::string::npos ? stage.size() : insert + 1;
+    }
+    //#line sets the number of the line after it, which is the first line after #version
+    int line = 1 + (int)std::count(stage.begin(), stage.begin() + insert, '\n');
+    stage.insert(insert, defines + "#line " + std::to_string(line) + "\n");
+}
+
+ShaderProgramSouce Shader::InjectDefines(const ShaderProgramSouce& source, const std::vector<std::string>& defines)
+{
+    if (defines.empty())
+        return source;
+    
+    std::string lines;
+    for (const std::string& define : defines)
+        lines += "#define " + define + "\n";
+    
+    ShaderProgramSouce result = source;
+    for (std::string* stage : { &result.VertexSource, &result.FragmentSource, &result.GeometrySource, &result.ComputeSource })
+        if (!stage->empty())
+            InsertDefines(*stage, lines);
+    return result;
+}
+
+void Shader::SetupProgram()
+{
+    BindUniformBlocks();
+    m_Reflection.Reflect(m_RendererID);
     
-    enum class ShaderType
+    //Catch blocks whose layout doesn't match the C++ side once here rather than as garbage on screen
+    for (const ShaderUniformBlock& block : m_Reflection.GetBlocks())
     {
-        NONE = -1, VERTEX = 0, FRAGMENT = 1
-    };
+        auto registered = UniformBuffer::GetRegisteredBlocks().find(block.Name);
+        if (registered != UniformBuffer::GetRegisteredBlocks().end() && (unsigned int)block.DataSize != registered->second.Size)
+            std::cout << "Warning: uniform block " << block.Name << " in " << m_Filepath << " is " << block.DataSize
+                << " bytes but the buffer for it is " << registered->second.Size << std::endl;
+    }
+}
+
+void Shader::ReplaceProgram(unsigned int program)
+{
+    unsigned int oldProgram = m_RendererID;
+    ShaderReflection oldReflection = m_Reflection;
+    
+    m_RendererID = program;
+    SetupProgram();
+    //First program this Shader has had, nothing to carry over
+    if (!oldProgram)
+        return;
+    CopyUniformValues(oldProgram, oldReflection);
     
-    //Search line by line for shader type using our #shader syntax
-    std::string line;
-    //1 stringsream for vertex shader, 1 for fragment shader
-    std::stringstream ss[2];
-    ShaderType type = ShaderType::NONE;
-    while(getline(stream, line))
+    GLCall(glDeleteProgram(oldProgram));
+    GLStateCache::OnProgramDeleted(oldProgram);
+}
+
+void Shader::CopyUniformValues(unsigned int oldProgram, const ShaderReflection& oldReflection)
+{
+    GLStateCache::UseProgram(m_RendererID);
+    for (const ShaderUniform& uniform : m_Reflection.GetUniforms())
     {
-        if(line.find("#shader") != std::string::npos)
+        //Block members live in their buffer and don't need copying
+        if (uniform.Location == -1)
+            continue;
+        
+        //Only runs on reload, so a linear search is fine
+        const ShaderUniform* old = nullptr;
+        for (const ShaderUniform& candidate : oldReflection.GetUniforms())
         {
-            //Find type of shader
-            if(line.find("vertex")!= std::string::npos)
-            {
-                type = ShaderType::VERTEX;
-            }
-            else if (line.find("fragment") != std::string::npos)
+            if (candidate.Name == uniform.Name)
             {
-                type = ShaderType::FRAGMENT;
+                old = &candidate;
+                break;
             }
         }
-        else
+        //New uniform or its type changed, leave it at the default the shader gives it
+        //Arrays only get their first element copied
+        if (!old || old->Location == -1 || old->Type != uniform.Type)
+            continue;
+        
+        float f[16];
+        int i[4];
+        switch (uniform.Type)
         {
-            //Line from file isn't a #shader line, need know which type to push to
-            //Using ararys in clever way to automate a little more
-            //Avoids if else if branch
-            ss[(int)type] << line << '\n';
+            case GL_FLOAT:
+                GLCall(glGetUniformfv(oldProgram, old->Location, f));
+                GLCall(glUniform1fv(uniform.Location, 1, f));
+                break;
+            case GL_FLOAT_VEC2:
+                GLCall(glGetUniformfv(oldProgram, old->Location, f));
+                GLCall(glUniform2fv(uniform.Location, 1, f));
+                break;
+            case GL_FLOAT_VEC3:
+                GLCall(glGetUniformfv(oldProgram, old->Location, f));
+                GLCall(glUniform3fv(uniform.Location, 1, f));
+                break;
+            case GL_FLOAT_VEC4:
+                GLCall(glGetUniformfv(oldProgram, old->Location, f));
+                GLCall(glUniform4fv(uniform.Location, 1, f));
+                break;
+            case GL_FLOAT_MAT3:
+                GLCall(glGetUniformfv(oldProgram, old->Location, f));
+                GLCall(glUniformMatrix3fv(uniform.Location, 1, GL_FALSE, f));
+                break;
+            case GL_FLOAT_MAT4:
+                GLCall(glGetUniformfv(oldProgram, old->Location, f));
+                GLCall(glUniformMatrix4fv(uniform.Location, 1, GL_FALSE, f));
+                break;
+            case GL_INT:
+            case GL_BOOL:
+                GLCall(glGetUniformiv(oldProgram, old->Location, i));
+                GLCall(glUniform1iv(uniform.Location, 1, i));
+                break;
+            default:
+                //Texture slot
+                if (ShaderReflection::IsSampler(uniform.Type))
+                {
+                    GLCall(glGetUniformiv(oldProgram, old->Location, i));
+                    GLCall(glUniform1iv(uniform.Location, 1, i));
+                }
+                break;
         }
     }
-    return { ss[0].str(), ss[1].str() };
 }
 
-
-//Abstract out shader compilation. Have to do multiple times
-unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
+void Shader::BindUniformBlocks()
 {
-    unsigned int id  = glCreateShader(type);
-    //source needs to exist at ths point
-    //If string goes out of scope this char* will point to garbage
-    const char* src = source.c_str();
-    GLCall(glShaderSource(id, 1, &src, nullptr));
-    GLCall(glCompileShader(id));
-    
-    //Can query result of glCompileShader
-    //iv
-    //i specifies we're specifying an integer
-    //v specifies it wants a vector, in this case really a pointer
-    int result;
-    GLCall(glGetShaderiv(id, GL_COMPILE_STATUS, &result));
-    if (result == GL_FALSE)
+    for (auto& block : UniformBuffer::GetRegisteredBlocks())
     {
-        //Shader didn't compile successfully
-        int length;
-        GLCall(glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length));
-        //Use alloca to keep message instantiation on stack
-        //Lets you allocate on stack dynamically
-        char* message = (char*)alloca(length * sizeof(char));
-        GLCall(glGetShaderInfoLog(id, length, &length, message));
-        std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader!" << std::endl;
-        std::cout << message << std::endl;
-        GLCall(glDeleteShader(id));
-        return 0;
+        GLCall(unsigned int index = glGetUniformBlockIndex(m_RendererID, block.first.c_str()));
+        if (index != GL_INVALID_INDEX)
+        {
+            GLCall(glUniformBlockBinding(m_RendererID, index, block.second.Binding));
+        }
     }
-    
-    return id;
-}
-
-//Both inputs are respective shader source code
-//Returns int for unique identifier
-unsigned int Shader::CreateShader(const std::string&vertexShader, const std::string& fragmentShader)
-{
-    unsigned int program = glCreateProgram();
-    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-    unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
-    
-    //Attach both shaders to program
-    //Think of this almost like compiling C++ code
-    //Link to 1 program
-    GLCall(glAttachShader(program, vs));
-    GLCall(glAttachShader(program, fs));
-    GLCall(glLinkProgram(program));
-    GLCall(glValidateProgram(program));
-    
-    //Can delete shaders since now linked into program
-    //Delete the intermediates (like .o objects in C++)
-    GLCall(glDeleteShader(vs));
-    GLCall(glDeleteShader(fs));
-    
-    return program;
 }
 
 void Shader::Bind() const
 {
-    GLCall(glUseProgram(m_RendererID));
+    RenderStats::OnShaderBind();
+    GLStateCache::UseProgram(m_RendererID);
 }
 void Shader::Unbind() const
 {
-    GLCall(glUseProgram(0));
+    GLStateCache::UseProgram(0);
+}
+
+void Shader::Dispatch(unsigned int groupsX, unsigned int groupsY, unsigned int groupsZ) const
+{
+    Bind();
+    GLCall(glDispatchCompute(groupsX, groupsY, groupsZ));
 }
 
 //Set uniforms
-void Shader::SetUniform1i(const std::string& name, int value)
+void Shader::SetUniform1i(UniformId name, int value)
 {
-    GLCall(glUniform1i(GetUniformLocation(name), value));
+    //Still building (or the build failed), there's no program for the value to go in
+    if (!m_RendererID)
+        return;
+    GLCall(glUniform1i(GetUniformLocation(name, GL_INT), value));
+    RenderStats::OnUniformUpload();
 }
 
-void Shader::SetUniform1f(const std::string& name, float value)
+void Shader::SetUniform1f(UniformId name, float value)
 {
-    GLCall(glUniform1f(GetUniformLocation(name), value));
+    if (!m_RendererID)
+        return;
+    GLCall(glUniform1f(GetUniformLocation(name, GL_FLOAT), value));
+    RenderStats::OnUniformUpload();
 }
 
 //If using a maths library would just use some kind of vec4 hereShader::
-void Shader::SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3)
+void Shader::SetUniform4f(UniformId name, float v0, float v1, float v2, float v3)
 {
-    GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3));
+    if (!m_RendererID)
+        return;
+    GLCall(glUniform4f(GetUniformLocation(name, GL_FLOAT_VEC4), v0, v1, v2, v3));
+    RenderStats::OnUniformUpload();
 }
 
 //
-void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix)
+void Shader::SetUniformMat4f(UniformId name, const glm::mat4& matrix)
 {
+    if (!m_RendererID)
+        return;
     //v means passing in array (float array)
     //If row major matrix would need to transpose
-    GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]));
+    GLCall(glUniformMatrix4fv(GetUniformLocation(name, GL_FLOAT_MAT4), 1, GL_FALSE, &matrix[0][0]));
+    RenderStats::OnUniformUpload();
 }
 
 //Marking as const because just supposed to retrieve uniform location, not really modifying shader or anything
-GLint Shader::GetUniformLocation(const std::string& name) const
+GLint Shader::GetUniformLocation(UniformId name, unsigned int type) const
 {
-    //Caching for performance boost 19:15
-    //Every time we set this uniform we retrieve the location
-    //Again, and again, and again -> Not very fast
-    //Retrieve it the first time and then we're done
-    if(m_UniformLocationCache.find(name) != m_UniformLocationCache.end())
-    {
-        return m_UniformLocationCache[name];
-    }
-    
-    GLCall(GLint location = glGetUniformLocation(m_RendererID, name.c_str()));
-    if (location == -1)
-    {
-        //Avoiding assert here because somtimes its quite valid for us to have -1 here
-        //Good if we delcare uniform but don't use it?
-        std::cout << "Warning: uniform " << name << " doesn't exist!" << std::endl;
-    }
-    
-    m_UniformLocationCache[name] = location;
-    return location;
+    //Reflection was filled when the program was created, so this never has to ask the driver
+    const ShaderUniform* uniform = m_Reflection.FindUniform(name);
+    if (!uniform || !ShaderReflection::CheckType(*uniform, type))
+        return -1;
+    return uniform->Location;
 }
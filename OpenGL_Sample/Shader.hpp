@@ -8,17 +8,29 @@
 #ifndef Shader_hpp
 #define Shader_hpp
 
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "glm/glm.hpp"
 
 #include "Renderer.h"
+#include "ShaderReflection.hpp"
+
+class ShaderBuildQueue;
 
 struct ShaderProgramSouce
 {
     std::string VertexSource;
     std::string FragmentSource;
+    //Optional, empty unless the file has a #shader geometry section
+    std::string GeometrySource;
+    //A compute shader makes a program on its own, a file with one shouldn't have any other stages
+    std::string ComputeSource;
+    //Every file pulled in with #include (nested ones too), so hot reload can watch them as well
+    std::vector<std::string> Includes;
+    
+    inline bool IsEmpty() const { return VertexSource.empty() && FragmentSource.empty() && GeometrySource.empty() && ComputeSource.empty(); }
 };
 
 //CPU representation of an actual compiled and created shader object on our GPU
@@ -28,11 +40,20 @@ private:
     //Really maintaining Filepath as a member for debug purposes
     std::string m_Filepath;
     unsigned int m_RendererID;
-    //caching for uniforms
-    //Mutable so that it can be modified in const GetUniformLocation function
-    mutable std::unordered_map<std::string, GLint> m_UniformLocationCache;
+    //Uniforms, blocks and attributes the program uses, read once right after it's created
+    //so setting a uniform never has to ask the driver where it is
+    ShaderReflection m_Reflection;
+    //Names #defined at the top of every stage, see ShaderVariants
+    std::vector<std::string> m_Defines;
+    //Set while the first build is still in a ShaderBuildQueue, so destroying the Shader early can cancel it
+    ShaderBuildQueue* m_BuildQueue;
+    uint64_t m_BuildId;
 public:
-    Shader(const std::string& filepath);
+    //Builds straight away, the program is ready when the constructor returns
+    Shader(const std::string& filepath, const std::vector<std::string>& defines = {});
+    //Only submits the build, nothing draws (and setting uniforms does nothing) until the queue finishes it
+    //Create every shader a scene needs like this and then call queue.Finish() so they compile in parallel
+    Shader(const std::string& filepath, ShaderBuildQueue& queue, const std::vector<std::string>& defines = {});
     ~Shader();
     
     //Naming bind for consistency
@@ -41,17 +62,42 @@ public:
     void Unbind() const;
     
     //Set uniforms
-    void SetUniform1i(const std::string& name, int value);
-    void SetUniform1f(const std::string& name, float value);
+    //UniformId converts from string literals, use a static constexpr UniformId in per draw code so it's hashed at compile time
+    void SetUniform1i(UniformId name, int value);
+    void SetUniform1f(UniformId name, float value);
     //If using a maths library would just use some kind of vec4 here
-    void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
-    void SetUniformMat4f(const std::string& name, const glm::mat4& matrix);
+    void SetUniform4f(UniformId name, float v0, float v1, float v2, float v3);
+    void SetUniformMat4f(UniformId name, const glm::mat4& matrix);
+    
+    //False until the build finishes, or for good if it failed
+    inline bool IsReady() const { return m_RendererID != 0; }
+    inline const ShaderReflection& GetReflection() const { return m_Reflection; }
+    inline const std::string& GetFilepath() const { return m_Filepath; }
+    inline const std::vector<std::string>& GetDefines() const { return m_Defines; }
+    
+    //Swaps in a freshly linked program (e.g. from ShaderWatcher after the file changed) and deletes the old one
+    //Uniform values the old program had are copied over, and the reflection is rebuilt for the new program
+    void ReplaceProgram(unsigned int program);
+    
+    //Compute programs only, binds the program and runs groupsX * groupsY * groupsZ work groups (needs GL 4.3)
+    void Dispatch(unsigned int groupsX, unsigned int groupsY = 1, unsigned int groupsZ = 1) const;
+    
+    //Only reads the file, doesn't touch GL, so it's safe to call from any thread (see ShaderParser)
+    static ShaderProgramSouce ParseShader(const std::string& filepath);
+    //Adds a #define line for each name right after #version in every stage (GLSL wants #version first)
+    //A #line directive follows them so compile errors still point at the right line of the file
+    static ShaderProgramSouce InjectDefines(const ShaderProgramSouce& source, const std::vector<std::string>& defines);
     
 private:
-    ShaderProgramSouce ParseShader(const std::string& filepath);
-    unsigned int CompileShader(unsigned int type, const std::string& source);
-    unsigned int CreateShader(const std::string&vertexShader, const std::string& fragmentShader);
-    GLint GetUniformLocation(const std::string& name) const;
+    void SubmitBuild(ShaderBuildQueue& queue);
+    //Everything that has to happen once m_RendererID is a linked program: block bindings and reflection
+    void SetupProgram();
+    //Points every block with a name registered through UniformBuffer::RegisterBlock at its binding point
+    void BindUniformBlocks();
+    //Sets every uniform of the current program to the value it had in oldProgram
+    void CopyUniformValues(unsigned int oldProgram, const ShaderReflection& oldReflection);
+    //-1 if the uniform isn't there or type (GL_FLOAT_MAT4 etc.) doesn't match what the shader declared
+    GLint GetUniformLocation(UniformId name, unsigned int type) const;
 };
 
 #endif /* Shader_hpp */
@@ -0,0 +1,273 @@
+//
+//  ShaderBuildQueue.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "ShaderBuildQueue.hpp"
+#include "CPUProfiler.hpp"
+#include "ShaderCache.hpp"
+
+#include <iostream>
+#include <thread>
+
+//glMaxShaderCompilerThreadsKHR is per context, but we only ever have the one
+static bool s_CompilerThreadsSet = false;
+
+static std::string GetShaderLog(unsigned int shader)
+{
+    int length = 0;
+    GLCall(glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length));
+    std::string log(length > 0 ? length : 1, '\0');
+    GLCall(glGetShaderInfoLog(shader, (GLsizei)log.size(), nullptr, &log[0]));
+    return log.c_str();
+}
+
+static std::string GetProgramLog(unsigned int program)
+{
+    int length = 0;
+    GLCall(glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length));
+    std::string log(length > 0 ? length : 1, '\0');
+    GLCall(glGetProgramInfoLog(program, (GLsizei)log.size(), nullptr, &log[0]));
+    return log.c_str();
+}
+
+static const char* GetStageName(unsigned int type)
+{
+    switch (type)
+    {
+        case GL_VERTEX_SHADER:   return "vertex";
+        case GL_FRAGMENT_SHADER: return "fragment";
+        case GL_GEOMETRY_SHADER: return "geometry";
+        case GL_COMPUTE_SHADER:  return "compute";
+        default:                 return "unknown";
+    }
+}
+
+//Only issues the compile, TryFinish asks whether it worked once the driver is done
+static unsigned int SubmitStage(unsigned int type, const std::string& source)
+{
+    unsigned int id = glCreateShader(type);
+    //source needs to exist at ths point
+    //If string goes out of scope this char* will point to garbage
+    const char* src = source.c_str();
+    GLCall(glShaderSource(id, 1, &src, nullptr));
+    GLCall(glCompileShader(id));
+    return id;
+}
+
+ShaderBuildQueue::ShaderBuildQueue()
+    : m_NextId(1)
+{
+}
+
+ShaderBuildQueue::~ShaderBuildQueue()
+{
+    //Nothing GL here, the shared instance outlives the context. Whoever made the queue should Finish or Shutdown it
+}
+
+ShaderBuildQueue& ShaderBuildQueue::Get()
+{
+    static ShaderBuildQueue queue;
+    return queue;
+}
+
+bool ShaderBuildQueue::IsParallel()
+{
+    return GLEW_KHR_parallel_shader_compile;
+}
+
+uint64_t ShaderBuildQueue::Submit(const std::string& name, const ShaderProgramSouce& source, Callback onFinished)
+{
+    CPU_PROFILE_FUNCTION();
+
+    //Let the driver use as many threads as it likes
+    if (IsParallel() && !s_CompilerThreadsSet)
+    {
+        GLCall(glMaxShaderCompilerThreadsKHR(0xFFFFFFFF));
+        s_CompilerThreadsSet = true;
+    }
+
+    Build build;
+    build.Id = m_NextId++;
+    build.Name = name;
+    build.OnFinished = onFinished;
+    build.StartTime = std::chrono::steady_clock::now();
+
+    //Skip compiling entirely if this driver has linked these exact sources before
+    build.CacheKey = ShaderCache::ComputeKey(source.VertexSource, source.FragmentSource, source.GeometrySource, source.ComputeSource);
+    {
+        CPU_PROFILE_SCOPE("ShaderCache::Load");
+        build.Program = ShaderCache::Load(build.CacheKey);
+    }
+    if (build.Program)
+    {
+        m_Builds.push_back(build);
+        return build.Id;
+    }
+
+    //Caught here rather than as a confusing link error, the callback still only runs from Update
+    bool hasGraphics = !source.VertexSource.empty() || !source.FragmentSource.empty() || !source.GeometrySource.empty();
+    if (!source.ComputeSource.empty() && (hasGraphics || !GLEW_VERSION_4_3))
+    {
+        if (hasGraphics)
+            std::cout << "Failed to build " << name << "! A compute shader has to be in a file on its own" << std::endl;
+        else
+            std::cout << "Failed to build " << name << "! Compute shaders need OpenGL 4.3" << std::endl;
+        m_Builds.push_back(build);
+        return build.Id;
+    }
+
+    const std::pair<unsigned int, const std::string*> stages[] =
+    {
+        { GL_VERTEX_SHADER, &source.VertexSource },
+        { GL_FRAGMENT_SHADER, &source.FragmentSource },
+        { GL_GEOMETRY_SHADER, &source.GeometrySource },
+        { GL_COMPUTE_SHADER, &source.ComputeSource },
+    };
+    
+    //Attach every stage to program
+    //Think of this almost like compiling C++ code
+    //Link to 1 program
+    build.Program = glCreateProgram();
+    for (const auto& stage : stages)
+    {
+        if (stage.second->empty())
+            continue;
+        unsigned int shader = SubmitStage(stage.first, *stage.second);
+        GLCall(glAttachShader(build.Program, shader));
+        build.Stages.push_back(std::make_pair(stage.first, shader));
+    }
+    //Has to be set before linking for glGetProgramBinary to work afterwards
+    if (ShaderCache::IsSupported())
+    {
+        GLCall(glProgramParameteri(build.Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+    //Linking a program whose shaders haven't compiled yet is fine, the driver chains the work
+    GLCall(glLinkProgram(build.Program));
+
+    m_Builds.push_back(build);
+    return build.Id;
+}
+
+void ShaderBuildQueue::Cancel(uint64_t id)
+{
+    for (size_t i = 0; i < m_Builds.size(); i++)
+    {
+        if (m_Builds[i].Id != id)
+            continue;
+        DeleteObjects(m_Builds[i]);
+        m_Builds.erase(m_Builds.begin() + i);
+        return;
+    }
+}
+
+void ShaderBuildQueue::Update()
+{
+    if (m_Builds.empty())
+        return;
+    CPU_PROFILE_FUNCTION();
+
+    //Pull finished builds out first, callbacks are free to Submit or Cancel
+    std::vector<Build> finished;
+    for (size_t i = 0; i < m_Builds.size();)
+    {
+        if (TryFinish(m_Builds[i]))
+        {
+            finished.push_back(std::move(m_Builds[i]));
+            m_Builds.erase(m_Builds.begin() + i);
+        }
+        else
+            i++;
+    }
+
+    for (Build& build : finished)
+        build.OnFinished(build.Program);
+}
+
+void ShaderBuildQueue::Finish()
+{
+    CPU_PROFILE_FUNCTION();
+    while (!m_Builds.empty())
+    {
+        Update();
+        //Compiler threads are busy, no point spinning on the status queries
+        if (!m_Builds.empty())
+            std::this_thread::yield();
+    }
+}
+
+void ShaderBuildQueue::Shutdown()
+{
+    for (Build& build : m_Builds)
+        DeleteObjects(build);
+    m_Builds.clear();
+}
+
+bool ShaderBuildQueue::TryFinish(Build& build)
+{
+    //Came out of the cache already linked (or Submit already said why it can't be built, Program is 0 then)
+    if (build.Stages.empty())
+        return true;
+
+    if (IsParallel())
+    {
+        int complete = GL_FALSE;
+        GLCall(glGetProgramiv(build.Program, GL_COMPLETION_STATUS_KHR, &complete));
+        if (complete == GL_FALSE)
+            return false;
+    }
+
+    //Can query result of glCompileShader
+    //iv
+    //i specifies we're specifying an integer
+    //v specifies it wants a vector, in this case really a pointer
+    bool compiled = true;
+    for (const auto& stage : build.Stages)
+    {
+        int result = GL_FALSE;
+        GLCall(glGetShaderiv(stage.second, GL_COMPILE_STATUS, &result));
+        if (result == GL_FALSE)
+        {
+            std::cout << "Failed to compile " << GetStageName(stage.first) << " shader in " << build.Name << "!\n" << GetShaderLog(stage.second) << std::endl;
+            compiled = false;
+        }
+    }
+    int linked = GL_FALSE;
+    GLCall(glGetProgramiv(build.Program, GL_LINK_STATUS, &linked));
+    if (compiled && linked == GL_FALSE)
+        std::cout << "Failed to link " << build.Name << "!\n" << GetProgramLog(build.Program) << std::endl;
+
+    //Can delete shaders since now linked into program
+    //Delete the intermediates (like .o objects in C++)
+    for (const auto& stage : build.Stages)
+    {
+        GLCall(glDeleteShader(stage.second));
+    }
+    build.Stages.clear();
+
+    if (linked == GL_FALSE)
+    {
+        GLCall(glDeleteProgram(build.Program));
+        build.Program = 0;
+        return true;
+    }
+
+    std::chrono::duration<double, std::milli> buildTime = std::chrono::steady_clock::now() - build.StartTime;
+    ShaderCache::Store(build.CacheKey, build.Program, buildTime.count());
+    return true;
+}
+
+void ShaderBuildQueue::DeleteObjects(Build& build)
+{
+    for (const auto& stage : build.Stages)
+    {
+        GLCall(glDeleteShader(stage.second));
+    }
+    //Builds Submit refused never made a program
+    if (build.Program)
+    {
+        GLCall(glDeleteProgram(build.Program));
+    }
+}
@@ -0,0 +1,75 @@
+//
+//  ShaderBuildQueue.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef ShaderBuildQueue_hpp
+#define ShaderBuildQueue_hpp
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Shader.hpp"
+
+//Compiles and links programs without waiting on each one in turn
+//  - Submit issues glCompileShader/glLinkProgram straight away but never asks for the result
+//  - Update checks on everything in flight, with KHR_parallel_shader_compile it only picks up builds
+//    the driver reports as finished (GL_COMPLETION_STATUS_KHR), so its compiler threads all work at once
+//  - Finish keeps calling Update until the queue is empty
+//Submitting N shaders and then finishing costs about as long as the slowest one on a parallel driver,
+//instead of the sum of all of them. Without the extension it behaves exactly like compiling one at a time
+class ShaderBuildQueue
+{
+public:
+    //Gets the linked program, or 0 if a stage didn't compile or the link failed (logs are printed already)
+    using Callback = std::function<void(unsigned int program)>;
+private:
+    struct Build
+    {
+        uint64_t Id = 0;
+        std::string Name;
+        uint64_t CacheKey = 0;
+        unsigned int Program = 0;
+        //GL_VERTEX_SHADER etc. and the shader object compiling it
+        //Empty when the program came straight out of the shader cache, or when Submit already knew it couldn't work
+        std::vector<std::pair<unsigned int, unsigned int>> Stages;
+        std::chrono::steady_clock::time_point StartTime;
+        Callback OnFinished;
+    };
+
+    std::vector<Build> m_Builds;
+    uint64_t m_NextId;
+public:
+    ShaderBuildQueue();
+    ~ShaderBuildQueue();
+
+    //Shared instance, main.cpp calls Update every frame and Shutdown before the context goes away
+    static ShaderBuildQueue& Get();
+
+    //Name is only used in log messages (usually the file path)
+    //Returns an id that can be passed to Cancel, callback runs from a later Update or Finish, never from Submit
+    uint64_t Submit(const std::string& name, const ShaderProgramSouce& source, Callback onFinished);
+    //Drops a build that hasn't finished yet, its callback never runs
+    void Cancel(uint64_t id);
+
+    void Update();
+    void Finish();
+    //Drops everything still in flight, needs the context to still be current
+    void Shutdown();
+
+    inline unsigned int GetPendingCount() const { return (unsigned int)m_Builds.size(); }
+    //True if the driver compiles in the background, i.e. Submit really doesn't block
+    static bool IsParallel();
+private:
+    //True once the build is done, whether it worked or not
+    bool TryFinish(Build& build);
+    void DeleteObjects(Build& build);
+};
+
+#endif /* ShaderBuildQueue_hpp */
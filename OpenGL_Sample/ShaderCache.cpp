@@ -0,0 +1,194 @@
+//
+//  ShaderCache.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "ShaderCache.hpp"
+#include "Renderer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <cstring>
+
+//Written at the start of every cache file
+struct ShaderCacheHeader
+{
+    //"GLPB"
+    uint32_t Magic;
+    uint32_t Version;
+    uint64_t Key;
+    uint32_t BinaryFormat;
+    uint32_t BinaryLength;
+    double CompileMs;
+};
+
+static const uint32_t s_Magic = 0x42504C47;
+static const uint32_t s_Version = 1;
+
+std::string ShaderCache::s_Directory;
+bool ShaderCache::s_Enabled = true;
+ShaderCacheStats ShaderCache::s_Stats;
+
+//FNV-1a, plenty for telling shader sources apart
+static uint64_t HashBytes(uint64_t hash, const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t HashString(uint64_t hash, const char* str)
+{
+    //Include the terminator so "ab" + "c" and "a" + "bc" don't collide
+    return HashBytes(hash, str ? str : "", (str ? strlen(str) : 0) + 1);
+}
+
+void ShaderCache::SetDirectory(const std::string& directory)
+{
+    s_Directory = directory;
+}
+
+bool ShaderCache::IsSupported()
+{
+    //-1 until the first call, glGet needs a current context
+    static int formats = -1;
+    if (formats < 0)
+    {
+        formats = 0;
+        if (GLEW_ARB_get_program_binary)
+        {
+            GLCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+        }
+    }
+    return formats > 0;
+}
+
+bool ShaderCache::IsFormatSupported(unsigned int format)
+{
+    //Doesn't change while the program runs, so only asked for once
+    static std::vector<GLint> formats;
+    static bool queried = false;
+    if (!queried)
+    {
+        queried = true;
+        GLint count = 0;
+        GLCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count));
+        formats.resize(count);
+        if (count > 0)
+        {
+            GLCall(glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data()));
+        }
+    }
+    return std::find(formats.begin(), formats.end(), (GLint)format) != formats.end();
+}
+
+uint64_t ShaderCache::ComputeKey(const std::string& vertexSource, const std::string& fragmentSource,
+                                 const std::string& geometrySource, const std::string& computeSource)
+{
+    uint64_t hash = 14695981039346656037ull;
+    hash = HashString(hash, vertexSource.c_str());
+    hash = HashString(hash, fragmentSource.c_str());
+    if (!geometrySource.empty())
+        hash = HashString(hash, ("geometry" + geometrySource).c_str());
+    if (!computeSource.empty())
+        hash = HashString(hash, ("compute" + computeSource).c_str());
+    //Driver update or different GPU means the old binaries are useless
+    hash = HashString(hash, (const char*)glGetString(GL_VENDOR));
+    hash = HashString(hash, (const char*)glGetString(GL_RENDERER));
+    hash = HashString(hash, (const char*)glGetString(GL_VERSION));
+    return hash;
+}
+
+std::string ShaderCache::GetPath(uint64_t key)
+{
+    if (s_Directory.empty())
+        s_Directory = (std::filesystem::temp_directory_path() / "OpenGL_Sample_shadercache").string();
+    
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return (std::filesystem::path(s_Directory) / name).string();
+}
+
+unsigned int ShaderCache::Load(uint64_t key)
+{
+    if (!s_Enabled || !IsSupported())
+    {
+        s_Stats.Misses++;
+        return 0;
+    }
+    
+    std::ifstream stream(GetPath(key), std::ios::binary);
+    ShaderCacheHeader header;
+    if (!stream.read((char*)&header, sizeof(header)) || header.Magic != s_Magic || header.Version != s_Version || header.Key != key)
+    {
+        s_Stats.Misses++;
+        return 0;
+    }
+    //e.g. written before a driver update, glProgramBinary would raise GL_INVALID_ENUM for a format it doesn't know
+    if (!IsFormatSupported(header.BinaryFormat))
+    {
+        s_Stats.Misses++;
+        return 0;
+    }
+    std::vector<char> binary(header.BinaryLength);
+    if (!stream.read(binary.data(), binary.size()))
+    {
+        s_Stats.Misses++;
+        return 0;
+    }
+    
+    GLCall(unsigned int program = glCreateProgram());
+    GLCall(glProgramBinary(program, header.BinaryFormat, binary.data(), header.BinaryLength));
+    //Driver is allowed to reject a binary for any reason, just means we compile as normal
+    int linked = GL_FALSE;
+    GLCall(glGetProgramiv(program, GL_LINK_STATUS, &linked));
+    if (linked == GL_FALSE)
+    {
+        GLCall(glDeleteProgram(program));
+        s_Stats.Misses++;
+        return 0;
+    }
+    
+    s_Stats.Hits++;
+    s_Stats.SavedMs += header.CompileMs;
+    return program;
+}
+
+void ShaderCache::Store(uint64_t key, unsigned int program, double compileMs)
+{
+    s_Stats.CompileMs += compileMs;
+    if (!s_Enabled || !IsSupported())
+        return;
+    
+    int length = 0;
+    GLCall(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0)
+        return;
+    
+    ShaderCacheHeader header = { s_Magic, s_Version, key, 0, 0, compileMs };
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLCall(glGetProgramBinary(program, length, &length, &format, binary.data()));
+    header.BinaryFormat = format;
+    header.BinaryLength = (uint32_t)length;
+    
+    std::string path = GetPath(key);
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        std::cout << "Warning: couldn't write shader cache file " << path << std::endl;
+        return;
+    }
+    stream.write((const char*)&header, sizeof(header));
+    stream.write(binary.data(), length);
+}
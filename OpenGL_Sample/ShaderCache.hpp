@@ -0,0 +1,62 @@
+//
+//  ShaderCache.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef ShaderCache_hpp
+#define ShaderCache_hpp
+
+#include <cstdint>
+#include <string>
+
+struct ShaderCacheStats
+{
+    unsigned int Hits = 0;
+    unsigned int Misses = 0;
+    //Time spent compiling and linking on misses this run
+    double CompileMs = 0.0;
+    //What the hits cost to compile when they were first stored, i.e. time we didn't spend this run
+    double SavedMs = 0.0;
+    
+    inline float GetHitRate() const { return Hits + Misses ? (float)Hits / (Hits + Misses) : 0.0f; }
+};
+
+//On disk cache of linked program binaries (glGetProgramBinary / glProgramBinary)
+//Keyed by a hash of the shader sources plus the driver's vendor, renderer and version strings,
+//since binaries are only valid for the exact driver that produced them
+class ShaderCache
+{
+public:
+    //Defaults to a folder in the system temp directory
+    static void SetDirectory(const std::string& directory);
+    
+    //Lets a test time real compiles, every Load misses and Store does nothing while disabled
+    inline static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+    inline static bool IsEnabled() { return s_Enabled; }
+    
+    //False if the driver doesn't expose any binary formats, every Load then misses and Store does nothing
+    static bool IsSupported();
+    
+    //Geometry and compute only change the key when they're used, so existing entries stay valid
+    static uint64_t ComputeKey(const std::string& vertexSource, const std::string& fragmentSource,
+                               const std::string& geometrySource = "", const std::string& computeSource = "");
+    
+    //Returns a linked program, or 0 on a miss (no file, or the driver rejected the binary)
+    static unsigned int Load(uint64_t key);
+    //Program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+    static void Store(uint64_t key, unsigned int program, double compileMs);
+    
+    inline static const ShaderCacheStats& GetStats() { return s_Stats; }
+private:
+    static std::string GetPath(uint64_t key);
+    //True if the driver currently lists format in GL_PROGRAM_BINARY_FORMATS
+    static bool IsFormatSupported(unsigned int format);
+    
+    static std::string s_Directory;
+    static bool s_Enabled;
+    static ShaderCacheStats s_Stats;
+};
+
+#endif /* ShaderCache_hpp */
@@ -0,0 +1,245 @@
+//
+//  ShaderParser.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "ShaderParser.hpp"
+#include "CPUProfiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+struct CachedInclude
+{
+    std::shared_ptr<const std::string> Contents;
+    std::filesystem::file_time_type Modified;
+};
+
+//Shared by every shader (and the watcher thread), so it's behind a mutex
+static std::mutex s_IncludeMutex;
+static std::unordered_map<std::string, CachedInclude> s_Includes;
+
+struct Line
+{
+    const char* Begin;
+    //Just past the last character, not counting the newline
+    const char* End;
+};
+
+//One allocation for the whole file instead of one per line
+static bool ReadFile(const std::string& path, std::string& contents)
+{
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream)
+        return false;
+    std::streamsize size = stream.tellg();
+    contents.resize((size_t)size);
+    stream.seekg(0);
+    return size == 0 || (bool)stream.read(&contents[0], size);
+}
+
+//Moves cursor past the next line, false once there's nothing left
+static bool NextLine(const char*& cursor, const char* end, Line& line)
+{
+    if (cursor >= end)
+        return false;
+    line.Begin = cursor;
+    const char* newline = (const char*)memchr(cursor, '\n', end - cursor);
+    line.End = newline ? newline : end;
+    cursor = newline ? newline + 1 : end;
+    return true;
+}
+
+static const char* SkipSpaces(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        p++;
+    return p;
+}
+
+//For "#word rest" lines sets directive to word and args to rest, false for every other line
+//Only lines whose first non blank character is # get past the first check, so most lines cost one compare
+static bool ParseDirective(const Line& line, std::string_view& directive, std::string_view& args)
+{
+    const char* p = SkipSpaces(line.Begin, line.End);
+    if (p == line.End || *p != '#')
+        return false;
+    p = SkipSpaces(p + 1, line.End);
+    const char* word = p;
+    while (p < line.End && ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z')))
+        p++;
+    directive = std::string_view(word, p - word);
+    p = SkipSpaces(p, line.End);
+    const char* argsEnd = line.End;
+    while (argsEnd > p && (argsEnd[-1] == ' ' || argsEnd[-1] == '\t' || argsEnd[-1] == '\r'))
+        argsEnd--;
+    args = std::string_view(p, argsEnd - p);
+    return true;
+}
+
+//"vertex", "fragment" etc. to the string that stage goes in, null if it's not a stage we know
+static std::string* GetStage(ShaderProgramSouce& source, std::string_view args)
+{
+    std::string_view type = args.substr(0, args.find_first_of(" \t"));
+    if (type == "vertex")
+        return &source.VertexSource;
+    if (type == "fragment")
+        return &source.FragmentSource;
+    if (type == "geometry")
+        return &source.GeometrySource;
+    if (type == "compute")
+        return &source.ComputeSource;
+    return nullptr;
+}
+
+//"file" or <file>, empty if it's neither
+static std::string_view GetIncludeName(std::string_view args)
+{
+    if (args.size() < 2)
+        return std::string_view();
+    char close = args[0] == '"' ? '"' : args[0] == '<' ? '>' : 0;
+    size_t end = close ? args.find(close, 1) : std::string_view::npos;
+    return end == std::string_view::npos ? std::string_view() : args.substr(1, end - 1);
+}
+
+ShaderProgramSouce ShaderParser::Parse(const std::string& filepath)
+{
+    CPU_PROFILE_FUNCTION();
+    ShaderProgramSouce source;
+    
+    std::string contents;
+    if (!ReadFile(filepath, contents))
+    {
+        std::cout << "Failed to open shader " << filepath << std::endl;
+        return source;
+    }
+    
+    //Includes in flight, so a file including itself (directly or not) doesn't recurse forever
+    std::vector<std::string> stack = { std::filesystem::path(filepath).lexically_normal().string() };
+    
+    //Stage the text is going in, null until the first #shader line
+    std::string* stage = nullptr;
+    //Start of the lines not yet appended to stage
+    const char* run = contents.data();
+    const char* cursor = contents.data();
+    const char* end = contents.data() + contents.size();
+    int lineNumber = 0;
+    int stageLine = 0;
+    
+    Line line;
+    while (NextLine(cursor, end, line))
+    {
+        lineNumber++;
+        std::string_view directive, args;
+        if (!ParseDirective(line, directive, args))
+            continue;
+        
+        if (directive == "shader")
+        {
+            if (stage)
+                stage->append(run, line.Begin);
+            stage = GetStage(source, args);
+            if (!stage)
+                std::cout << filepath << ":" << lineNumber << ": unknown stage in " << std::string(line.Begin, line.End) << std::endl;
+            stageLine = lineNumber;
+            run = cursor;
+        }
+        else if (directive == "include" && stage)
+        {
+            stage->append(run, line.Begin);
+            AppendInclude(*stage, filepath, std::string(GetIncludeName(args)), stack, source.Includes);
+            //Line numbers in compile errors carry on as if the include was still one line
+            *stage += "#line " + std::to_string(lineNumber - stageLine + 1) + "\n";
+            run = cursor;
+        }
+    }
+    if (stage)
+        stage->append(run, end);
+    
+    return source;
+}
+
+void ShaderParser::AppendInclude(std::string& out, const std::string& includer, const std::string& name, std::vector<std::string>& stack,
+                                 std::vector<std::string>& includes)
+{
+    if (name.empty())
+    {
+        std::cout << "Bad #include in " << includer << ", expected #include \"file\"" << std::endl;
+        return;
+    }
+    
+    std::string path = (std::filesystem::path(includer).parent_path() / name).lexically_normal().string();
+    if (std::find(stack.begin(), stack.end(), path) != stack.end())
+    {
+        std::cout << "Recursive #include of " << path << " from " << includer << std::endl;
+        return;
+    }
+    //Recorded before opening it, so creating a missing include still triggers a reload
+    if (std::find(includes.begin(), includes.end(), path) == includes.end())
+        includes.push_back(path);
+    std::shared_ptr<const std::string> contents = GetInclude(path);
+    if (!contents)
+    {
+        std::cout << "Couldn't open #include \"" << name << "\" in " << includer << std::endl;
+        return;
+    }
+    
+    stack.push_back(path);
+    const char* run = contents->data();
+    const char* cursor = contents->data();
+    const char* end = contents->data() + contents->size();
+    Line line;
+    while (NextLine(cursor, end, line))
+    {
+        std::string_view directive, args;
+        if (!ParseDirective(line, directive, args) || directive != "include")
+            continue;
+        out.append(run, line.Begin);
+        AppendInclude(out, path, std::string(GetIncludeName(args)), stack, includes);
+        run = cursor;
+    }
+    out.append(run, end);
+    //Last line of the include mustn't run into the line after the #include
+    if (!contents->empty() && contents->back() != '\n')
+        out += '\n';
+    stack.pop_back();
+}
+
+std::shared_ptr<const std::string> ShaderParser::GetInclude(const std::string& path)
+{
+    std::error_code error;
+    std::filesystem::file_time_type modified = std::filesystem::last_write_time(path, error);
+    if (error)
+        return nullptr;
+    
+    std::lock_guard<std::mutex> lock(s_IncludeMutex);
+    auto cached = s_Includes.find(path);
+    if (cached != s_Includes.end() && cached->second.Modified == modified)
+        return cached->second.Contents;
+    
+    std::shared_ptr<std::string> contents = std::make_shared<std::string>();
+    if (!ReadFile(path, *contents))
+        return nullptr;
+    s_Includes[path] = { contents, modified };
+    return contents;
+}
+
+void ShaderParser::ClearIncludeCache()
+{
+    std::lock_guard<std::mutex> lock(s_IncludeMutex);
+    s_Includes.clear();
+}
+
+unsigned int ShaderParser::GetIncludeCacheSize()
+{
+    std::lock_guard<std::mutex> lock(s_IncludeMutex);
+    return (unsigned int)s_Includes.size();
+}
@@ -0,0 +1,42 @@
+//
+//  ShaderParser.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef ShaderParser_hpp
+#define ShaderParser_hpp
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Shader.hpp"
+
+//Turns a .shader file into per stage sources
+//  - The whole file is read in one go and scanned once, lines are never copied on their own,
+//    everything between two directives is appended to its stage in one piece
+//  - #shader vertex / fragment / geometry / compute starts a stage, anything before the first one is ignored
+//  - #include "file" pastes in another file (relative to the one including it), nested includes work too
+//    Included files are kept in a cache shared by every shader and only read again once they change on disk
+//    Their paths end up in ShaderProgramSouce::Includes
+//Safe to call from any thread, the hot reload watcher parses on its own thread
+class ShaderParser
+{
+public:
+    static ShaderProgramSouce Parse(const std::string& filepath);
+    
+    //Includes are otherwise only reread when their modification time changes
+    static void ClearIncludeCache();
+    static unsigned int GetIncludeCacheSize();
+private:
+    //Pastes the include named on a directive line into out, along with whatever it includes
+    //Every path it tries to include is added to includes (once), even ones that couldn't be opened
+    static void AppendInclude(std::string& out, const std::string& includer, const std::string& name, std::vector<std::string>& stack,
+                              std::vector<std::string>& includes);
+    //Contents of a file from the include cache, reading it if it's new or changed. Null if it can't be read
+    static std::shared_ptr<const std::string> GetInclude(const std::string& path);
+};
+
+#endif /* ShaderParser_hpp */
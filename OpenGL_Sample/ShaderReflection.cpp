@@ -0,0 +1,257 @@
+//
+//  ShaderReflection.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "ShaderReflection.hpp"
+#include "Renderer.h"
+
+#include <cstring>
+#include <iostream>
+
+void ShaderReflection::Reflect(unsigned int program)
+{
+    m_Program = program;
+    m_Uniforms.clear();
+    m_Blocks.clear();
+    m_Attributes.clear();
+    m_UniformNames.clear();
+    m_UniformLookup.Clear();
+    m_ArrayElements.clear();
+    m_BlockLookup.Clear();
+    
+    GLint count = 0, maxLength = 0;
+    
+    //Uniforms, samplers included since they're just int uniforms with a sampler type
+    GLCall(glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count));
+    GLCall(glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength));
+    std::vector<char> name(maxLength + 1);
+    m_Uniforms.reserve(count);
+    for (GLint i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        GLCall(glGetActiveUniform(program, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data()));
+        GLuint index = (GLuint)i;
+        GLint blockIndex = -1;
+        GLCall(glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex));
+        GLCall(GLint location = glGetUniformLocation(program, name.data()));
+        
+        ShaderUniform uniform;
+        uniform.Name.assign(name.data(), length);
+        uniform.Type = type;
+        uniform.Size = size;
+        uniform.Location = location;
+        uniform.BlockIndex = blockIndex;
+        m_Uniforms.push_back(uniform);
+    }
+    for (int i = 0; i < (int)m_Uniforms.size(); i++)
+    {
+        const std::string& uniformName = m_Uniforms[i].Name;
+        AddName(uniformName, i, false);
+        //Arrays are reported as "u_Textures[0]", let "u_Textures" find the first element too
+        if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+            AddName(uniformName.substr(0, uniformName.size() - 3), i, false);
+    }
+    
+    //Uniform blocks
+    GLCall(glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count));
+    GLCall(glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength));
+    name.assign(maxLength + 1, 0);
+    for (GLint i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLCall(glGetActiveUniformBlockName(program, (GLuint)i, (GLsizei)name.size(), &length, name.data()));
+        
+        ShaderUniformBlock block;
+        block.Name.assign(name.data(), length);
+        block.Index = (unsigned int)i;
+        GLCall(glGetActiveUniformBlockiv(program, (GLuint)i, GL_UNIFORM_BLOCK_DATA_SIZE, &block.DataSize));
+        GLCall(glGetActiveUniformBlockiv(program, (GLuint)i, GL_UNIFORM_BLOCK_BINDING, &block.Binding));
+        m_Blocks.push_back(block);
+        m_BlockLookup.Insert(UniformId::Hash(block.Name.c_str()), (int)m_Blocks.size() - 1);
+    }
+    
+    //Vertex attributes
+    GLCall(glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count));
+    GLCall(glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength));
+    name.assign(maxLength + 1, 0);
+    for (GLint i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        GLCall(glGetActiveAttrib(program, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data()));
+        
+        ShaderAttribute attribute;
+        attribute.Name.assign(name.data(), length);
+        attribute.Type = type;
+        attribute.Size = size;
+        GLCall(attribute.Location = glGetAttribLocation(program, name.data()));
+        m_Attributes.push_back(attribute);
+    }
+}
+
+const ShaderUniform* ShaderReflection::FindUniform(UniformId id) const
+{
+    int index = FindName(id.GetHash(), id.GetName());
+    if (index >= 0)
+        return GetUniform(m_UniformNames[index]);
+    
+    //First time we've seen this name, whatever the answer is gets remembered
+    int element = FindArrayElement(id.GetName());
+    if (element < 0)
+    {
+        //Avoiding assert here because somtimes its quite valid for us to have -1 here
+        //Good if we delcare uniform but don't use it?
+        std::cout << "Warning: uniform " << id.GetName() << " doesn't exist!" << std::endl;
+    }
+    AddName(id.GetName(), element, true);
+    return element >= 0 ? &m_ArrayElements[element] : nullptr;
+}
+
+const ShaderUniformBlock* ShaderReflection::FindBlock(UniformId id) const
+{
+    int index = m_BlockLookup.Find(id.GetHash());
+    //Another name with the same hash isn't this block
+    return index >= 0 && m_Blocks[index].Name == id.GetName() ? &m_Blocks[index] : nullptr;
+}
+
+int ShaderReflection::FindName(uint32_t hash, const char* name) const
+{
+    //Hashes only narrow it down, the name has to match too
+    for (int index = m_UniformLookup.Find(hash); index >= 0; index = m_UniformNames[index].Next)
+    {
+        if (m_UniformNames[index].Name == name)
+            return index;
+    }
+    return -1;
+}
+
+void ShaderReflection::AddName(const std::string& name, int index, bool element) const
+{
+    int entry = (int)m_UniformNames.size();
+    m_UniformNames.push_back({ name, index, element, -1 });
+    
+    uint32_t hash = UniformId::Hash(name.c_str());
+    int last = m_UniformLookup.Find(hash);
+    if (last < 0)
+    {
+        m_UniformLookup.Insert(hash, entry);
+        return;
+    }
+    //Same hash as a name we already have, chain it on the end
+    while (m_UniformNames[last].Next >= 0)
+        last = m_UniformNames[last].Next;
+    m_UniformNames[last].Next = entry;
+}
+
+const ShaderUniform* ShaderReflection::GetUniform(const UniformName& name) const
+{
+    if (name.Index < 0)
+        return nullptr;
+    return name.Element ? &m_ArrayElements[name.Index] : &m_Uniforms[name.Index];
+}
+
+int ShaderReflection::FindArrayElement(const char* name) const
+{
+    const char* bracket = strchr(name, '[');
+    size_t length = strlen(name);
+    if (!bracket || bracket == name || name[length - 1] != ']')
+        return -1;
+    
+    //Element 0 is the one GL listed, it has the type every other element shares
+    std::string first = std::string(name, bracket) + "[0]";
+    int index = FindName(UniformId::Hash(first.c_str()), first.c_str());
+    const ShaderUniform* array = index >= 0 ? GetUniform(m_UniformNames[index]) : nullptr;
+    if (!array)
+        return -1;
+    
+    GLCall(GLint location = glGetUniformLocation(m_Program, name));
+    if (location < 0)
+        return -1;
+    
+    ShaderUniform element = *array;
+    element.Name = name;
+    element.Size = 1;
+    element.Location = location;
+    element.TypeWarned = false;
+    m_ArrayElements.push_back(element);
+    return (int)m_ArrayElements.size() - 1;
+}
+
+bool ShaderReflection::CheckType(const ShaderUniform& uniform, unsigned int type)
+{
+    //Samplers and bools are set with glUniform1i
+    bool matches = uniform.Type == type || (type == GL_INT && (IsSampler(uniform.Type) || uniform.Type == GL_BOOL));
+    if (!matches && !uniform.TypeWarned)
+    {
+        std::cout << "Warning: uniform " << uniform.Name << " is a " << GetTypeName(uniform.Type)
+            << " but is being set as a " << GetTypeName(type) << std::endl;
+        uniform.TypeWarned = true;
+    }
+    return matches;
+}
+
+bool ShaderReflection::IsSampler(unsigned int type)
+{
+    switch (type)
+    {
+        case GL_SAMPLER_1D:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_SHADOW:
+        case GL_SAMPLER_1D_ARRAY:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_2D_ARRAY_SHADOW:
+        case GL_SAMPLER_BUFFER:
+        case GL_SAMPLER_2D_MULTISAMPLE:
+        case GL_INT_SAMPLER_2D:
+        case GL_INT_SAMPLER_2D_ARRAY:
+        case GL_UNSIGNED_INT_SAMPLER_2D:
+        case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+            return true;
+        default:
+            return false;
+    }
+}
+
+const char* ShaderReflection::GetTypeName(unsigned int type)
+{
+    switch (type)
+    {
+        case GL_FLOAT: return "float";
+        case GL_FLOAT_VEC2: return "vec2";
+        case GL_FLOAT_VEC3: return "vec3";
+        case GL_FLOAT_VEC4: return "vec4";
+        case GL_INT: return "int";
+        case GL_INT_VEC2: return "ivec2";
+        case GL_INT_VEC3: return "ivec3";
+        case GL_INT_VEC4: return "ivec4";
+        case GL_UNSIGNED_INT: return "uint";
+        case GL_BOOL: return "bool";
+        case GL_FLOAT_MAT2: return "mat2";
+        case GL_FLOAT_MAT3: return "mat3";
+        case GL_FLOAT_MAT4: return "mat4";
+        case GL_SAMPLER_2D: return "sampler2D";
+        case GL_SAMPLER_2D_ARRAY: return "sampler2DArray";
+        case GL_SAMPLER_CUBE: return "samplerCube";
+        default: return IsSampler(type) ? "sampler" : "unknown type";
+    }
+}
+
+void ShaderReflection::Print(const std::string& label) const
+{
+    std::cout << label << ": " << m_Uniforms.size() << " uniforms, " << m_Blocks.size() << " blocks, " << m_Attributes.size() << " attributes" << std::endl;
+    for (const ShaderUniform& uniform : m_Uniforms)
+        std::cout << "  uniform " << GetTypeName(uniform.Type) << " " << uniform.Name << (uniform.Size > 1 ? "[" + std::to_string(uniform.Size) + "]" : "")
+            << " location " << uniform.Location << (uniform.BlockIndex >= 0 ? " in block " + std::to_string(uniform.BlockIndex) : "") << std::endl;
+    for (const ShaderUniformBlock& block : m_Blocks)
+        std::cout << "  block " << block.Name << " " << block.DataSize << " bytes, binding " << block.Binding << std::endl;
+    for (const ShaderAttribute& attribute : m_Attributes)
+        std::cout << "  attribute " << GetTypeName(attribute.Type) << " " << attribute.Name << " location " << attribute.Location << std::endl;
+}
@@ -0,0 +1,109 @@
+//
+//  ShaderReflection.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef ShaderReflection_hpp
+#define ShaderReflection_hpp
+
+#include <string>
+#include <vector>
+
+#include "UniformId.hpp"
+
+struct ShaderUniform
+{
+    std::string Name;
+    //GL_FLOAT_MAT4, GL_SAMPLER_2D, ...
+    unsigned int Type;
+    //Array length, 1 for plain uniforms
+    int Size;
+    //-1 for uniforms inside a uniform block, those are set through the buffer instead
+    int Location;
+    //Uniform block it lives in, or -1
+    int BlockIndex;
+    //So a wrong SetUniform call only complains once
+    mutable bool TypeWarned = false;
+};
+
+struct ShaderUniformBlock
+{
+    std::string Name;
+    unsigned int Index;
+    //Bytes the buffer bound to it needs to have
+    int DataSize;
+    //Binding point it reads from
+    int Binding;
+};
+
+struct ShaderAttribute
+{
+    std::string Name;
+    unsigned int Type;
+    int Size;
+    int Location;
+};
+
+//Everything the linked program says it uses, read once right after linking so per frame code never has to ask the driver
+//Each kind lives in its own contiguous array, uniforms and blocks can also be found by UniformId through a hash table
+//Array elements past [0] aren't listed by GL, the driver is asked for those once and the answer is kept
+class ShaderReflection
+{
+private:
+    //Every name that has been looked up (or that a uniform is known by)
+    struct UniformName
+    {
+        std::string Name;
+        //Into m_Uniforms, or m_ArrayElements if Element is set. -1 for names we've already warned about
+        int Index;
+        bool Element;
+        //Next name with the same hash, -1 at the end
+        int Next;
+    };
+    
+    unsigned int m_Program = 0;
+    std::vector<ShaderUniform> m_Uniforms;
+    std::vector<ShaderUniformBlock> m_Blocks;
+    std::vector<ShaderAttribute> m_Attributes;
+    mutable std::vector<UniformName> m_UniformNames;
+    //Hash -> first entry in m_UniformNames with that hash, different names can share one
+    mutable UniformHashTable m_UniformLookup;
+    //"u_Textures[3]" and the like
+    mutable std::vector<ShaderUniform> m_ArrayElements;
+    UniformHashTable m_BlockLookup;
+public:
+    //Needs the program to be linked, replaces whatever was there before
+    void Reflect(unsigned int program);
+    
+    //nullptr if the program doesn't have (or optimised out) that uniform
+    //The first miss for each name prints a warning, after that misses are silent and just as cheap as hits
+    const ShaderUniform* FindUniform(UniformId id) const;
+    const ShaderUniformBlock* FindBlock(UniformId id) const;
+    
+    //Prints a warning the first time a SetUniform call doesn't match the type declared in the shader
+    //Returns false on a mismatch
+    static bool CheckType(const ShaderUniform& uniform, unsigned int type);
+    
+    inline const std::vector<ShaderUniform>& GetUniforms() const { return m_Uniforms; }
+    inline const std::vector<ShaderUniformBlock>& GetBlocks() const { return m_Blocks; }
+    inline const std::vector<ShaderAttribute>& GetAttributes() const { return m_Attributes; }
+    
+    static bool IsSampler(unsigned int type);
+    //"mat4", "sampler2D", ... for messages
+    static const char* GetTypeName(unsigned int type);
+    
+    //Lists everything found, handy when a shader doesn't behave
+    void Print(const std::string& label) const;
+private:
+    //Index into m_UniformNames, or -1 if that name has never been seen
+    int FindName(uint32_t hash, const char* name) const;
+    void AddName(const std::string& name, int index, bool element) const;
+    const ShaderUniform* GetUniform(const UniformName& name) const;
+    //Asks the driver for "u_Textures[3]" when "u_Textures[0]" is a uniform
+    //Index into m_ArrayElements, or -1 if there's no such element
+    int FindArrayElement(const char* name) const;
+};
+
+#endif /* ShaderReflection_hpp */
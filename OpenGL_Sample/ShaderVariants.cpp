@@ -0,0 +1,69 @@
+//
+//  ShaderVariants.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "ShaderVariants.hpp"
+#include "CPUProfiler.hpp"
+#include "ShaderBuildQueue.hpp"
+
+ShaderVariants::ShaderVariants(const std::string& filepath)
+    : ShaderVariants(filepath, GetDefaultFeatures())
+{
+}
+
+ShaderVariants::ShaderVariants(const std::string& filepath, const std::vector<std::string>& features)
+    : m_Filepath(filepath), m_Features(features)
+{
+}
+
+const std::vector<std::string>& ShaderVariants::GetDefaultFeatures()
+{
+    static const std::vector<std::string> features = { "COLORED", "TINT", "ALPHA_TEST" };
+    return features;
+}
+
+uint32_t ShaderVariants::Sanitize(uint32_t mask) const
+{
+    //Stray bits would otherwise give two masks for the same variant
+    return m_Features.size() >= 32 ? mask : mask & ((1u << m_Features.size()) - 1);
+}
+
+std::vector<std::string> ShaderVariants::GetDefines(uint32_t mask) const
+{
+    std::vector<std::string> defines;
+    for (size_t i = 0; i < m_Features.size() && i < 32; i++)
+        if (mask & (1u << i))
+            defines.push_back(m_Features[i]);
+    return defines;
+}
+
+Shader& ShaderVariants::Get(uint32_t mask)
+{
+    mask = Sanitize(mask);
+    auto variant = m_Variants.find(mask);
+    if (variant != m_Variants.end())
+        return *variant->second;
+    
+    CPU_PROFILE_SCOPE("ShaderVariants build");
+    std::unique_ptr<Shader>& shader = m_Variants[mask];
+    shader = std::make_unique<Shader>(m_Filepath, GetDefines(mask));
+    return *shader;
+}
+
+void ShaderVariants::Prepare(const std::vector<uint32_t>& masks, ShaderBuildQueue& queue)
+{
+    for (uint32_t mask : masks)
+    {
+        mask = Sanitize(mask);
+        if (!m_Variants.count(mask))
+            m_Variants[mask] = std::make_unique<Shader>(m_Filepath, queue, GetDefines(mask));
+    }
+}
+
+bool ShaderVariants::IsBuilt(uint32_t mask) const
+{
+    return m_Variants.count(Sanitize(mask)) != 0;
+}
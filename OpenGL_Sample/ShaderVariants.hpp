@@ -0,0 +1,69 @@
+//
+//  ShaderVariants.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef ShaderVariants_hpp
+#define ShaderVariants_hpp
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Shader.hpp"
+
+class ShaderBuildQueue;
+
+//Feature bits for the default list, basic.shader understands all of them
+enum ShaderFeature : uint32_t
+{
+    ShaderFeature_None      = 0,
+    //Flat u_Color instead of sampling u_Texture
+    ShaderFeature_Colored   = 1 << 0,
+    //Multiplies the result by u_Color
+    ShaderFeature_Tint      = 1 << 1,
+    //Discards pixels with alpha below u_AlphaCutoff
+    ShaderFeature_AlphaTest = 1 << 2,
+};
+
+//Every combination of features one shader file can be built with
+//Bit i of a mask #defines Features[i] in both stages, e.g. 0b101 with the default list is COLORED + ALPHA_TEST
+//Variants are only built the first time they're asked for and then kept by mask, so a scene only ever
+//compiles the ones it draws with (and with the program binary cache, usually not even those)
+class ShaderVariants
+{
+private:
+    std::string m_Filepath;
+    std::vector<std::string> m_Features;
+    std::unordered_map<uint32_t, std::unique_ptr<Shader>> m_Variants;
+public:
+    //Uses GetDefaultFeatures
+    ShaderVariants(const std::string& filepath);
+    ShaderVariants(const std::string& filepath, const std::vector<std::string>& features);
+    
+    //COLORED, TINT, ALPHA_TEST, in ShaderFeature order
+    static const std::vector<std::string>& GetDefaultFeatures();
+    
+    //Builds the variant (blocking) the first time, bits past the end of the feature list are ignored
+    //A variant Prepare submitted comes back straight away, check IsReady if its queue might not be finished
+    Shader& Get(uint32_t mask);
+    //Submits every variant in masks that doesn't exist yet, call queue.Finish() to build them all in parallel
+    void Prepare(const std::vector<uint32_t>& masks, ShaderBuildQueue& queue);
+    
+    bool IsBuilt(uint32_t mask) const;
+    inline unsigned int GetBuiltCount() const { return (unsigned int)m_Variants.size(); }
+    //Every variant built so far, for setting a uniform on all of them
+    inline const std::unordered_map<uint32_t, std::unique_ptr<Shader>>& GetBuilt() const { return m_Variants; }
+    //1 << feature count
+    inline unsigned int GetPossibleCount() const { return 1u << m_Features.size(); }
+    //The names a mask turns on
+    std::vector<std::string> GetDefines(uint32_t mask) const;
+private:
+    uint32_t Sanitize(uint32_t mask) const;
+};
+
+#endif /* ShaderVariants_hpp */
@@ -0,0 +1,296 @@
+//
+//  ShaderWatcher.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "ShaderWatcher.hpp"
+#include "CPUProfiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+//How long the watcher thread sleeps between checks, also how long Shutdown can wait for it
+static const int s_PollIntervalMs = 250;
+
+static std::string GetDirectory(const std::string& path)
+{
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? "." : path.substr(0, slash);
+}
+
+ShaderWatcher::ShaderWatcher()
+    : m_Quit(false), m_ReloadCount(0), m_FailedCount(0)
+{
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+    //Context is long gone by the time statics are destroyed, only the thread needs stopping
+    m_Quit = true;
+    if (m_Thread.joinable())
+        m_Thread.join();
+}
+
+ShaderWatcher& ShaderWatcher::Get()
+{
+    static ShaderWatcher watcher;
+    return watcher;
+}
+
+void ShaderWatcher::Start()
+{
+    if (m_Thread.joinable())
+        return;
+    
+    m_Quit = false;
+    m_Thread = std::thread(&ShaderWatcher::WatchLoop, this);
+}
+
+void ShaderWatcher::Shutdown()
+{
+    m_Quit = true;
+    if (m_Thread.joinable())
+        m_Thread.join();
+    
+    m_Queue.Shutdown();
+    m_Builds.clear();
+    
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Changes.clear();
+}
+
+void ShaderWatcher::Watch(Shader& shader)
+{
+    m_Shaders.push_back(&shader);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Files[shader.GetFilepath()]++;
+}
+
+void ShaderWatcher::Unwatch(Shader& shader)
+{
+    CancelBuild(shader);
+    m_Shaders.erase(std::remove(m_Shaders.begin(), m_Shaders.end(), &shader), m_Shaders.end());
+    
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto file = m_Files.find(shader.GetFilepath());
+    if (file != m_Files.end() && --file->second == 0)
+        m_Files.erase(file);
+}
+
+std::set<std::string> ShaderWatcher::GetWatchedPaths(std::map<std::string, unsigned int>& files)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        files = m_Files;
+    }
+    
+    //Forget shaders nobody uses anymore
+    for (auto include = m_Includes.begin(); include != m_Includes.end();)
+        include = files.count(include->first) ? std::next(include) : m_Includes.erase(include);
+    
+    std::set<std::string> paths;
+    for (const auto& file : files)
+    {
+        paths.insert(file.first);
+        auto includes = m_Includes.find(file.first);
+        if (includes == m_Includes.end())
+            includes = m_Includes.emplace(file.first, Shader::ParseShader(file.first).Includes).first;
+        paths.insert(includes->second.begin(), includes->second.end());
+    }
+    return paths;
+}
+
+void ShaderWatcher::PushChanges(const std::vector<std::string>& paths, const std::map<std::string, unsigned int>& files)
+{
+    //Shader files that need parsing again, an include shared by several shaders only reloads each of them once
+    std::set<std::string> shaders;
+    for (const std::string& path : paths)
+    {
+        if (files.count(path))
+            shaders.insert(path);
+        for (const auto& includes : m_Includes)
+        {
+            if (std::find(includes.second.begin(), includes.second.end(), path) != includes.second.end())
+                shaders.insert(includes.first);
+        }
+    }
+    
+    for (const std::string& path : shaders)
+    {
+        Change change;
+        change.Path = path;
+        {
+            CPU_PROFILE_SCOPE("ShaderWatcher parse");
+            change.Source = Shader::ParseShader(path);
+        }
+        //Editors can truncate the file before writing it, wait for the write that has something in it
+        if (change.Source.IsEmpty())
+            continue;
+        //Includes may have been added or removed
+        m_Includes[path] = change.Source.Includes;
+        
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Changes.push_back(change);
+    }
+}
+
+#ifdef __linux__
+
+void ShaderWatcher::WatchLoop()
+{
+    CPU_PROFILE_THREAD("ShaderWatcher");
+    
+    int fd = inotify_init1(IN_NONBLOCK);
+    if (fd < 0)
+    {
+        std::cout << "ShaderWatcher: inotify_init1 failed, shader hot reload is off" << std::endl;
+        return;
+    }
+    
+    //Watching directories rather than files, editors often save by writing a new file and renaming
+    //it over the old one, which would silently kill a watch on the file itself
+    std::map<int, std::string> directories;
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    
+    while (!m_Quit)
+    {
+        std::map<std::string, unsigned int> files;
+        std::set<std::string> paths = GetWatchedPaths(files);
+        for (const std::string& file : paths)
+        {
+            std::string directory = GetDirectory(file);
+            bool watched = false;
+            for (const auto& entry : directories)
+                watched = watched || entry.second == directory;
+            if (watched)
+                continue;
+            int wd = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if (wd >= 0)
+                directories[wd] = directory;
+        }
+        
+        //Timeout so m_Quit and newly watched files get picked up
+        pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, s_PollIntervalMs) <= 0)
+            continue;
+        
+        //Several events for the same file usually arrive together, only parse it once
+        std::set<std::string> changed;
+        ssize_t length;
+        while ((length = read(fd, buffer, sizeof(buffer))) > 0)
+        {
+            for (char* ptr = buffer; ptr < buffer + length; ptr += sizeof(inotify_event) + ((inotify_event*)ptr)->len)
+            {
+                const inotify_event* event = (const inotify_event*)ptr;
+                auto directory = directories.find(event->wd);
+                if (event->len == 0 || directory == directories.end())
+                    continue;
+                std::string path = directory->second + "/" + event->name;
+                if (paths.count(path))
+                    changed.insert(path);
+            }
+        }
+        PushChanges(std::vector<std::string>(changed.begin(), changed.end()), files);
+    }
+    
+    close(fd);
+}
+
+#else
+
+//No inotify on macOS, FSEvents would need CoreServices so just compare modification times
+void ShaderWatcher::WatchLoop()
+{
+    CPU_PROFILE_THREAD("ShaderWatcher");
+    
+    std::map<std::string, struct timespec> times;
+    while (!m_Quit)
+    {
+        std::map<std::string, unsigned int> files;
+        std::set<std::string> paths = GetWatchedPaths(files);
+        
+        std::vector<std::string> changed;
+        for (const std::string& file : paths)
+        {
+            struct stat info;
+            if (stat(file.c_str(), &info) != 0)
+                continue;
+#ifdef __APPLE__
+            struct timespec modified = info.st_mtimespec;
+#else
+            struct timespec modified = info.st_mtim;
+#endif
+            auto known = times.find(file);
+            if (known == times.end())
+                times[file] = modified;
+            else if (known->second.tv_sec != modified.tv_sec || known->second.tv_nsec != modified.tv_nsec)
+            {
+                known->second = modified;
+                changed.push_back(file);
+            }
+        }
+        PushChanges(changed, files);
+        
+        std::this_thread::sleep_for(std::chrono::milliseconds(s_PollIntervalMs));
+    }
+}
+
+#endif
+
+void ShaderWatcher::Update()
+{
+    CPU_PROFILE_FUNCTION();
+    
+    std::deque<Change> changes;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        changes.swap(m_Changes);
+    }
+    
+    for (const Change& change : changes)
+    {
+        for (Shader* shader : m_Shaders)
+        {
+            if (shader->GetFilepath() != change.Path)
+                continue;
+            //Newer source wins, no point finishing a build of what was just overwritten
+            CancelBuild(*shader);
+            m_Builds[shader] = m_Queue.Submit(change.Path, Shader::InjectDefines(change.Source, shader->GetDefines()), [this, shader](unsigned int program)
+            {
+                m_Builds.erase(shader);
+                if (!program)
+                {
+                    //Old program is untouched, keep drawing with it until the file is fixed
+                    m_FailedCount++;
+                    std::cout << "Keeping the previous version of " << shader->GetFilepath() << std::endl;
+                    return;
+                }
+                shader->ReplaceProgram(program);
+                m_ReloadCount++;
+                std::cout << "Reloaded " << shader->GetFilepath() << std::endl;
+            });
+        }
+    }
+    
+    m_Queue.Update();
+}
+
+void ShaderWatcher::CancelBuild(Shader& shader)
+{
+    auto build = m_Builds.find(&shader);
+    if (build == m_Builds.end())
+        return;
+    m_Queue.Cancel(build->second);
+    m_Builds.erase(build);
+}
@@ -0,0 +1,89 @@
+//
+//  ShaderWatcher.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef ShaderWatcher_hpp
+#define ShaderWatcher_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Shader.hpp"
+#include "ShaderBuildQueue.hpp"
+
+//Hot reloads shader files while the app is running
+//  - A background thread watches the files of every live Shader and everything they #include
+//    (inotify on Linux, mtime polling elsewhere) and parses them as soon as they're saved.
+//    Saving an include reloads every shader that includes it
+//  - Update (GL thread, once per frame) submits the new sources to a ShaderBuildQueue and checks on builds
+//    from earlier frames, with KHR_parallel_shader_compile the driver does the work on its own threads
+//    and we only pick the program up once it's finished
+//  - A successful build is swapped into the existing Shader object, a failed one prints its log and
+//    the old program keeps drawing
+class ShaderWatcher
+{
+private:
+    struct Change
+    {
+        std::string Path;
+        ShaderProgramSouce Source;
+    };
+    
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::atomic<bool> m_Quit;
+    //Watched files and how many Shaders use each, shared with the watcher thread
+    std::map<std::string, unsigned int> m_Files;
+    //Parsed on the watcher thread, waiting for Update
+    std::deque<Change> m_Changes;
+    //Watcher thread only, the includes of each file in m_Files as of its last parse
+    std::map<std::string, std::vector<std::string>> m_Includes;
+    
+    //GL thread only from here down
+    std::vector<Shader*> m_Shaders;
+    ShaderBuildQueue m_Queue;
+    //Build in m_Queue for each Shader that has one in flight
+    std::map<Shader*, uint64_t> m_Builds;
+    unsigned int m_ReloadCount;
+    unsigned int m_FailedCount;
+public:
+    ShaderWatcher();
+    ~ShaderWatcher();
+    
+    //Shared instance, Shader registers itself in its constructor and destructor
+    static ShaderWatcher& Get();
+    
+    //Starts the watcher thread, needs a current context. Nothing gets reloaded until this is called
+    void Start();
+    void Update();
+    //Stops the thread and drops builds still in flight, needs the context to still be current
+    void Shutdown();
+    
+    void Watch(Shader& shader);
+    void Unwatch(Shader& shader);
+    
+    inline bool IsRunning() const { return m_Thread.joinable(); }
+    inline unsigned int GetReloadCount() const { return m_ReloadCount; }
+    inline unsigned int GetFailedCount() const { return m_FailedCount; }
+private:
+    void WatchLoop();
+    //Watcher thread, copies m_Files and returns every path to watch: those files plus their includes
+    //Files seen for the first time are parsed once to find their includes
+    std::set<std::string> GetWatchedPaths(std::map<std::string, unsigned int>& files);
+    //paths can be shader files or includes, every shader file affected is parsed and handed over to Update
+    void PushChanges(const std::vector<std::string>& paths, const std::map<std::string, unsigned int>& files);
+    
+    void CancelBuild(Shader& shader);
+};
+
+#endif /* ShaderWatcher_hpp */
@@ -0,0 +1,206 @@
+//
+//  StreamingBuffer.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "StreamingBuffer.hpp"
+#include "Renderer.h"
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
+
+#include <cstring>
+
+//Everything that isn't a draw (creating, mapping, orphaning) goes through GL_COPY_WRITE_BUFFER
+//Binding GL_ELEMENT_ARRAY_BUFFER would silently attach the buffer to whatever vertex array is bound
+static const unsigned int s_ScratchTarget = GL_COPY_WRITE_BUFFER;
+
+StreamingBuffer::StreamingBuffer(unsigned int target, unsigned int regionSize, unsigned int regionCount)
+    : m_RendererID(0), m_Target(target), m_RegionSize(regionSize), m_RegionCount(regionCount),
+    m_Region(0), m_Offset(0), m_Persistent(false), m_MappedData(nullptr), m_Fences(regionCount, nullptr), m_StallCount(0), m_GrowCount(0)
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+    Allocate();
+}
+
+void StreamingBuffer::Allocate()
+{
+    GLCall(glBindBuffer(s_ScratchTarget, m_RendererID));
+    
+    unsigned int size = GetSize();
+    if (GLEW_ARB_buffer_storage)
+    {
+        //Immutable storage that stays mapped for the buffer's whole life
+        //Coherent means our writes show up for the GPU without any explicit flush
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLCall(glBufferStorage(s_ScratchTarget, size, nullptr, flags));
+        GLCall(m_MappedData = (unsigned char*)glMapBufferRange(s_ScratchTarget, 0, size, flags));
+        m_Persistent = m_MappedData != nullptr;
+    }
+    if (!m_Persistent)
+    {
+        GLCall(glBufferData(s_ScratchTarget, size, nullptr, GL_STREAM_DRAW));
+    }
+    GLCall(glBindBuffer(s_ScratchTarget, 0));
+}
+
+StreamingBuffer::~StreamingBuffer()
+{
+    for (GLsync fence : m_Fences)
+    {
+        if (fence)
+        {
+            GLCall(glDeleteSync(fence));
+        }
+    }
+    if (m_Persistent)
+    {
+        GLCall(glBindBuffer(s_ScratchTarget, m_RendererID));
+        GLCall(glUnmapBuffer(s_ScratchTarget));
+        GLCall(glBindBuffer(s_ScratchTarget, 0));
+    }
+    GLCall(glDeleteBuffers(1, &m_RendererID));
+    GLStateCache::OnBufferDeleted(m_RendererID);
+}
+
+unsigned int StreamingBuffer::Write(const void* data, unsigned int size, unsigned int alignment)
+{
+    RenderStats::OnBufferUpload(size);
+    
+    //Aligned relative to the start of the whole buffer since that's what offset / stride gets measured from
+    unsigned int regionStart = m_Region * m_RegionSize;
+    unsigned int bufferOffset = (regionStart + m_Offset + alignment - 1) / alignment * alignment;
+    if (bufferOffset + size > regionStart + m_RegionSize)
+    {
+        //This frame has outgrown its region. The next region could be one we fenced earlier this frame,
+        //so rather than wait on draws we only just issued, make room for the whole frame so far plus this write
+        Grow(m_Offset + size + alignment);
+        regionStart = 0;
+        bufferOffset = 0;
+    }
+    m_Offset = bufferOffset + size - regionStart;
+    
+    if (m_Persistent)
+    {
+        memcpy(m_MappedData + bufferOffset, data, size);
+        return bufferOffset;
+    }
+    
+    GLCall(glBindBuffer(s_ScratchTarget, m_RendererID));
+    //Unsynchronized is safe because we never write over a range the GPU could still be reading
+    //Invalidate range tells the driver it doesn't need to preserve the old contents
+    GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    GLCall(void* mapped = glMapBufferRange(s_ScratchTarget, bufferOffset, size, access));
+    if (mapped)
+    {
+        memcpy(mapped, data, size);
+        GLCall(glUnmapBuffer(s_ScratchTarget));
+    }
+    GLCall(glBindBuffer(s_ScratchTarget, 0));
+    return bufferOffset;
+}
+
+void StreamingBuffer::NextFrame()
+{
+    //Nothing written yet this frame, no point burning a region
+    if (m_Offset == 0)
+        return;
+    AdvanceRegion();
+}
+
+void StreamingBuffer::Grow(unsigned int minRegionSize)
+{
+    unsigned int regionSize = m_RegionSize * 2;
+    while (regionSize < minRegionSize)
+        regionSize *= 2;
+    m_RegionSize = regionSize;
+    
+    //Fences belonged to the old storage, nothing in the new storage is in use yet
+    for (GLsync& fence : m_Fences)
+    {
+        if (fence)
+        {
+            GLCall(glDeleteSync(fence));
+            fence = nullptr;
+        }
+    }
+    
+    if (m_Persistent)
+    {
+        //Immutable storage can't be resized, so swap in a new buffer
+        //The old one stays alive until the draws already issued from it are done
+        GLCall(glBindBuffer(s_ScratchTarget, m_RendererID));
+        GLCall(glUnmapBuffer(s_ScratchTarget));
+        GLCall(glBindBuffer(s_ScratchTarget, 0));
+        GLCall(glDeleteBuffers(1, &m_RendererID));
+        GLStateCache::OnBufferDeleted(m_RendererID);
+        m_Persistent = false;
+        m_MappedData = nullptr;
+        GLCall(glGenBuffers(1, &m_RendererID));
+        Allocate();
+    }
+    else
+    {
+        //Same as orphaning, draws already issued keep the old storage
+        GLCall(glBindBuffer(s_ScratchTarget, m_RendererID));
+        GLCall(glBufferData(s_ScratchTarget, GetSize(), nullptr, GL_STREAM_DRAW));
+        GLCall(glBindBuffer(s_ScratchTarget, 0));
+    }
+    
+    m_Region = 0;
+    m_Offset = 0;
+    m_GrowCount++;
+}
+
+void StreamingBuffer::AdvanceRegion()
+{
+    if (m_Persistent)
+    {
+        //GPU is done with the region we're leaving once it gets past this point in the command stream
+        GLCall(m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    }
+    
+    m_Region = (m_Region + 1) % m_RegionCount;
+    m_Offset = 0;
+    
+    if (!m_Persistent)
+    {
+        //Wrapped around, orphan so the previous storage can stay alive for any draws still reading it
+        if (m_Region == 0)
+        {
+            GLCall(glBindBuffer(s_ScratchTarget, m_RendererID));
+            GLCall(glBufferData(s_ScratchTarget, GetSize(), nullptr, GL_STREAM_DRAW));
+            GLCall(glBindBuffer(s_ScratchTarget, 0));
+        }
+        return;
+    }
+    
+    GLsync& fence = m_Fences[m_Region];
+    if (!fence)
+        return;
+    
+    //First check without waiting, in the common case the GPU finished with this region ages ago
+    GLCall(GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0));
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        m_StallCount++;
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            //1ms at a time
+            GLCall(result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+        }
+    }
+    GLCall(glDeleteSync(fence));
+    fence = nullptr;
+}
+
+void StreamingBuffer::Bind() const
+{
+    GLStateCache::BindBuffer(m_Target, m_RendererID);
+}
+
+void StreamingBuffer::Unbind() const
+{
+    GLStateCache::BindBuffer(m_Target, 0);
+}
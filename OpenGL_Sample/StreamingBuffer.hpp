@@ -0,0 +1,79 @@
+//
+//  StreamingBuffer.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef StreamingBuffer_hpp
+#define StreamingBuffer_hpp
+
+#include <vector>
+
+#include <GL/glew.h>
+
+//Big GPU buffer for data that gets rewritten every frame (batched vertices, dynamic indices, instance data)
+//Split into regionCount regions, one per frame, used round robin. Only NextFrame moves on to the next region,
+//so it's the only place a fence gets set, and we only wait on that fence when we come back around.
+//With 3 regions the GPU has 2 frames to finish reading before the CPU could possibly catch up with it
+//
+//A frame that writes more than a region holds makes the buffer grow (regions at least double) instead of spilling
+//into the next region, which could still be fenced from earlier in the same frame. Draws already issued keep reading
+//the old storage, and after a frame or two at the new size it stops happening
+//
+//GL 4.4 / ARB_buffer_storage: mapped once, persistently and coherently, writes are a plain memcpy
+//  The storage is immutable, so growing swaps in a new buffer. Check GetGrowCount and re-attach it to any vertex array
+//GL 3.3 (macOS): each write maps just its range with GL_MAP_UNSYNCHRONIZED_BIT, and the whole buffer is
+//orphaned every time we wrap back to the first region so the driver hands us fresh memory instead of waiting
+class StreamingBuffer
+{
+private:
+    unsigned int m_RendererID;
+    //GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER, used when binding for draws
+    unsigned int m_Target;
+    unsigned int m_RegionSize;
+    unsigned int m_RegionCount;
+    
+    unsigned int m_Region;
+    //Write position inside the current region
+    unsigned int m_Offset;
+    
+    bool m_Persistent;
+    //Start of the whole buffer when persistently mapped, nullptr otherwise
+    unsigned char* m_MappedData;
+    //One per region, nullptr if nothing has been fenced there yet
+    std::vector<GLsync> m_Fences;
+    //Times we actually had to wait on the GPU, should stay at 0
+    unsigned int m_StallCount;
+    //Times a frame didn't fit in its region
+    unsigned int m_GrowCount;
+public:
+    //regionSize is the most one frame is expected to write, more than that still works but grows the buffer
+    StreamingBuffer(unsigned int target, unsigned int regionSize, unsigned int regionCount = 3);
+    ~StreamingBuffer();
+    
+    //Copies data into the buffer and returns its byte offset from the start of the buffer
+    //The offset is a multiple of alignment, e.g. pass the vertex stride to be able to use offset / stride as a base vertex
+    //Never waits on the GPU, if the frame runs out of room the buffer grows instead
+    unsigned int Write(const void* data, unsigned int size, unsigned int alignment = 1);
+    
+    //Fences off this frame's region and moves on to the next one, call once per frame
+    void NextFrame();
+    
+    void Bind() const;
+    void Unbind() const;
+    
+    inline bool IsPersistent() const { return m_Persistent; }
+    inline unsigned int GetStallCount() const { return m_StallCount; }
+    //Changes whenever the buffer grew, which on the persistent path means it's a different buffer now
+    inline unsigned int GetGrowCount() const { return m_GrowCount; }
+    inline unsigned int GetSize() const { return m_RegionSize * m_RegionCount; }
+private:
+    //Creates storage for GetSize() bytes on m_RendererID, persistently mapped if we can
+    void Allocate();
+    //Makes every region at least minRegionSize bytes and starts over at the first one
+    void Grow(unsigned int minRegionSize);
+    void AdvanceRegion();
+};
+
+#endif /* StreamingBuffer_hpp */
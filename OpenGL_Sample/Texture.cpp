@@ -6,49 +6,455 @@
 //
 
 #include "Texture.hpp"
+#include "CPUProfiler.hpp"
+#include "GLStateCache.hpp"
+#include "TextureResidency.hpp"
 
 #include "stb_image/stb_image.h"
+#include "RenderStats.hpp"
 
-Texture::Texture(const std::string &path)
-    : m_RendererID(0), m_FilePath(path), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(0)
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+//Colors are weighted by alpha so the fully transparent pixels around a sprite (often black) don't darken its edges
+//Integer maths all the way, so every platform and driver ends up with exactly the same bytes
+void Texture::Downsample(const unsigned char* src, int width, int height, unsigned char* dst)
 {
-    stbi_set_flip_vertically_on_load(1);
-    //stbi_load writes to m_Width, m_Height, m_BPP. 4 is for RGBA
-    m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4);
+    int dstWidth = std::max(1, width / 2);
+    int dstHeight = std::max(1, height / 2);
+    for (int y = 0; y < dstHeight; y++)
+    {
+        //Odd sizes (and 1 pixel wide/high levels) just reuse the last row or column
+        const unsigned char* row0 = src + (size_t)std::min(y * 2, height - 1) * width * 4;
+        const unsigned char* row1 = src + (size_t)std::min(y * 2 + 1, height - 1) * width * 4;
+        unsigned char* out = dst + (size_t)y * dstWidth * 4;
+        for (int x = 0; x < dstWidth; x++)
+        {
+            int x0 = std::min(x * 2, width - 1) * 4;
+            int x1 = std::min(x * 2 + 1, width - 1) * 4;
+            const unsigned char* p[4] = { row0 + x0, row0 + x1, row1 + x0, row1 + x1 };
+            unsigned int alpha = p[0][3] + p[1][3] + p[2][3] + p[3][3];
+            for (int c = 0; c < 3; c++)
+            {
+                if (alpha)
+                    out[c] = (unsigned char)((p[0][c] * p[0][3] + p[1][c] * p[1][3] + p[2][c] * p[2][3] + p[3][c] * p[3][3] + alpha / 2) / alpha);
+                else
+                    out[c] = (unsigned char)((p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) / 4);
+            }
+            out[3] = (unsigned char)((alpha + 2) / 4);
+            out += 4;
+        }
+    }
+}
+
+Texture::Texture(const std::string &path, const TextureOptions& options)
+    : m_RendererID(0), m_FilePath(path), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(0), m_Options(options), m_MipLevels(1),
+      m_Format(GL_RGBA8), m_MemorySize(0), m_Resident(true), m_LastUsedFrame(0)
+{
+    CPU_PROFILE_FUNCTION();
+    Create();
+    if (!CompressedImage::IsCompressedPath(path))
+    {
+        LoadImage(path);
+        return;
+    }
+    if (LoadCompressed(path))
+        return;
+    
+    //Broken file, or a format this driver can't sample (BC7 and ETC2 on macOS)
+    std::string fallback = std::filesystem::path(path).replace_extension(".png").string();
+    std::cout << "Loading " << fallback << " instead" << std::endl;
+    LoadImage(fallback);
+}
     
+Texture::Texture(const CompressedImage& image, const TextureOptions& options)
+    : m_RendererID(0), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(0), m_Options(options), m_MipLevels(1),
+      m_Format(GL_RGBA8), m_MemorySize(0), m_Resident(true), m_LastUsedFrame(0)
+{
+    CPU_PROFILE_SCOPE("Texture upload");
+    Create();
+    SetCompressedImage(image);
+}
+
+Texture::Texture(int width, int height, const void* pixels, const TextureOptions& options)
+    : m_RendererID(0), m_LocalBuffer(nullptr), m_Width(width), m_Height(height), m_BPP(4), m_Options(options), m_MipLevels(1),
+      m_Format(GL_RGBA8), m_MemorySize(0), m_Resident(true), m_LastUsedFrame(0)
+{
+    CPU_PROFILE_SCOPE("Texture upload");
+    Create();
+    SetImage(width, height, pixels);
+}
+
+Texture::~Texture()
+{
+    TextureResidency::Unregister(this);
+    //Evicted textures have already given their name back
+    if (m_RendererID)
+    {
+        GLCall(glDeleteTextures(1, &m_RendererID));
+        GLStateCache::OnTextureDeleted(m_RendererID);
+    }
+    SetMemorySize(0);
+    RenderStats::OnObjectDestroyed(GLObjectType::Texture);
+}
+
+void Texture::Create()
+{
+    RenderStats::OnObjectCreated(GLObjectType::Texture);
+    TextureResidency::Register(this);
+    CreateName();
+}
+
+void Texture::CreateName()
+{
     GLCall(glGenTextures(1, &m_RendererID));
-    GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+    BindForUpdate();
     
-    //Need to specify these parameters or will get a black texture
-    //Details on these params to come in future video
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
-    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    ApplySampling();
+    Unbind();
+}
+
+void Texture::SetMemorySize(unsigned long long bytes)
+{
+    RenderStats::OnMemoryFreed(GLObjectType::Texture, m_MemorySize);
+    RenderStats::OnMemoryAllocated(GLObjectType::Texture, bytes);
+    m_MemorySize = bytes;
+}
+
+void Texture::Evict()
+{
+    if (!m_Resident)
+        return;
+    CPU_PROFILE_FUNCTION();
     
+    //Nothing to keep if the file can be read again, otherwise read the image back before it's gone
+    if (m_SourcePath.empty() && m_MemorySize)
+    {
+        //glGetTexImage reads from the active unit, BindForUpdate makes sure that's unit 0 with this texture on it
+        //even when another unit was active and this texture was already bound to 0
+        BindForUpdate();
+        if (IsCompressed())
+        {
+            m_EvictedImage = std::make_unique<CompressedImage>();
+            m_EvictedImage->Format = m_Format;
+            m_EvictedImage->Width = m_Width;
+            m_EvictedImage->Height = m_Height;
+            //Rows are still in GL's order
+            m_EvictedImage->BottomUp = true;
+            m_EvictedImage->AllocateLevels(m_MipLevels);
+            for (int level = 0; level < m_MipLevels; level++)
+            {
+                GLCall(glGetCompressedTexImage(GL_TEXTURE_2D, level, &m_EvictedImage->Data[m_EvictedImage->Levels[level].Offset]));
+            }
+        }
+        else
+        {
+            //Mipmaps are built again from level 0 on the way back
+            m_EvictedPixels.resize((size_t)m_Width * m_Height * 4);
+            GLCall(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_EvictedPixels.data()));
+        }
+    }
+    
+    //Deleting the name is the only way to be sure the driver frees every level
+    GLCall(glDeleteTextures(1, &m_RendererID));
+    GLStateCache::OnTextureDeleted(m_RendererID);
+    m_RendererID = 0;
+    SetMemorySize(0);
+    m_Resident = false;
+}
+
+void Texture::Restore()
+{
+    CPU_PROFILE_FUNCTION();
+    auto start = std::chrono::steady_clock::now();
+    //Set first, the uploads below go through the same functions a resident texture uses
+    m_Resident = true;
+    CreateName();
+    
+    if (!m_SourcePath.empty())
+    {
+        std::string path = m_SourcePath;
+        if (!CompressedImage::IsCompressedPath(path) || !LoadCompressed(path))
+            LoadImage(path);
+    }
+    else if (m_EvictedImage)
+    {
+        std::unique_ptr<CompressedImage> image = std::move(m_EvictedImage);
+        SetCompressedImage(*image);
+    }
+    else
+    {
+        std::vector<unsigned char> pixels;
+        pixels.swap(m_EvictedPixels);
+        SetImage(m_Width, m_Height, pixels.empty() ? nullptr : pixels.data());
+    }
+    TextureResidency::OnRestored(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+}
+
+void Texture::LoadImage(const std::string& path)
+{
+    {
+        CPU_PROFILE_SCOPE("Texture decode");
+        stbi_set_flip_vertically_on_load(1);
+        //stbi_load writes to m_Width, m_Height, m_BPP. 4 is for RGBA
+        m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4);
+    }
+    
+    CPU_PROFILE_SCOPE("Texture upload");
     //Give OpenGL the data
-    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
-    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+    SetImage(m_Width, m_Height, m_LocalBuffer);
     
     if(m_LocalBuffer)
+    {
         stbi_image_free(m_LocalBuffer);
+        m_SourcePath = path;
+    }
+    m_LocalBuffer = nullptr;
 }
 
-Texture::~Texture()
+bool Texture::LoadCompressed(const std::string& path)
 {
-    GLCall(glDeleteTextures(1, &m_RendererID));
+    CompressedImage image;
+    {
+        CPU_PROFILE_SCOPE("Texture read");
+        if (!CompressedImage::Load(path, image))
+            return false;
+    }
+    CPU_PROFILE_SCOPE("Texture upload");
+    if (!SetCompressedImage(image))
+        return false;
+    m_SourcePath = path;
+    return true;
+}
+
+void Texture::ApplySampling()
+{
+    //Need to specify these parameters or will get a black texture
+    //Minifying without mipmaps reads texels all over the place (aliasing, and the texture cache hates it),
+    //with them the GPU reads from a level close to the size it's drawn at
+    GLenum minFilter = GL_LINEAR;
+    if (m_Options.Mipmaps != MipmapMode::None)
+        minFilter = m_Options.Trilinear ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_NEAREST;
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_Options.Wrap));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_Options.Wrap));
+    
+    //Takes more samples along the direction a surface is squashed in, only helps things seen at an angle
+    float maxAnisotropy = GetMaxAnisotropy();
+    if (maxAnisotropy > 1.0f)
+    {
+        GLCall(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, std::min(std::max(m_Options.Anisotropy, 1.0f), maxAnisotropy)));
+    }
+}
+
+void Texture::SetSampling(bool trilinear, float anisotropy)
+{
+    m_Options.Trilinear = trilinear;
+    m_Options.Anisotropy = anisotropy;
+    //Evicted textures pick the new sampling up when they're created again
+    if (!m_Resident)
+        return;
+    BindForUpdate();
+    ApplySampling();
+    Unbind();
+}
+
+float Texture::GetMaxAnisotropy()
+{
+    //-1 until the first call, glGet needs a current context
+    static float maxAnisotropy = -1.0f;
+    if (maxAnisotropy < 0.0f)
+    {
+        maxAnisotropy = 1.0f;
+        if (GLEW_ARB_texture_filter_anisotropic || GLEW_EXT_texture_filter_anisotropic)
+        {
+            GLCall(glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy));
+        }
+    }
+    return maxAnisotropy;
+}
+
+int Texture::GetMipLevelCount(int width, int height)
+{
+    int levels = 1;
+    for (int size = std::max(width, height); size > 1; size /= 2)
+        levels++;
+    return levels;
+}
+
+void Texture::UploadCPUMips(const unsigned char* pixels)
+{
+    CPU_PROFILE_FUNCTION();
+    const unsigned char* src = pixels;
+    int width = m_Width, height = m_Height;
+    //Ping pong between two buffers, level 0 is read straight from pixels
+    std::vector<unsigned char> levels[2];
+    unsigned long long bytes = 0;
+    for (int level = 1; level < m_MipLevels; level++)
+    {
+        int levelWidth = std::max(1, width / 2);
+        int levelHeight = std::max(1, height / 2);
+        std::vector<unsigned char>& dst = levels[level % 2];
+        dst.resize((size_t)levelWidth * levelHeight * 4);
+        Downsample(src, width, height, dst.data());
+        GLCall(glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, levelWidth, levelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, dst.data()));
+        bytes += dst.size();
+        
+        src = dst.data();
+        width = levelWidth;
+        height = levelHeight;
+    }
+    RenderStats::OnTextureUpload(bytes);
+}
+
+void Texture::SetImage(int width, int height, const void* pixels)
+{
+    ReplaceEvicted();
+    m_Width = width;
+    m_Height = height;
+    m_Format = GL_RGBA8;
+    m_SourcePath.clear();
+    BindForUpdate();
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    if (pixels)
+        RenderStats::OnTextureUpload((unsigned long long)width * height * 4);
+    
+    m_MipLevels = 1;
+    if (m_Options.Mipmaps != MipmapMode::None && width > 0 && height > 0)
+    {
+        m_MipLevels = GetMipLevelCount(width, height);
+        //pixels is an offset when an unpack buffer is bound, so the CPU can't read it
+        GLint unpackBuffer = 0;
+        if (m_Options.Mipmaps == MipmapMode::CPUBox)
+        {
+            GLCall(glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &unpackBuffer));
+        }
+        if (m_Options.Mipmaps == MipmapMode::CPUBox && pixels && !unpackBuffer)
+            UploadCPUMips((const unsigned char*)pixels);
+        else
+        {
+            GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+        }
+    }
+    //Levels past this were never uploaded, without it a mipmapped min filter would see an incomplete texture
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_MipLevels - 1));
+    Unbind();
+    
+    unsigned long long bytes = 0;
+    for (int level = 0; level < m_MipLevels; level++)
+        bytes += (unsigned long long)std::max(1, width >> level) * std::max(1, height >> level) * 4;
+    SetMemorySize(bytes);
+}
+
+bool Texture::SetCompressedImage(const CompressedImage& image)
+{
+    if (!CompressedImage::IsFormatSupported(image.Format))
+    {
+        std::cout << "Warning: this driver can't sample " << CompressedImage::GetFormatName(image.Format) << " textures" << std::endl;
+        return false;
+    }
+    if (!image.BottomUp)
+    {
+        //Load already flips files it can, this is for images made in memory
+        CompressedImage flipped = image;
+        if (flipped.FlipVertically())
+            return SetCompressedImage(flipped);
+        std::cout << "Warning: " << CompressedImage::GetFormatName(image.Format) << " image is stored top row first and will be upside down "
+            << m_FilePath << std::endl;
+    }
+    
+    ReplaceEvicted();
+    m_Width = image.Width;
+    m_Height = image.Height;
+    m_Format = image.Format;
+    m_SourcePath.clear();
+    //Only the levels in the file, glGenerateMipmap doesn't work on compressed formats
+    m_MipLevels = m_Options.Mipmaps == MipmapMode::None ? 1 : (int)image.Levels.size();
+    if (m_Options.Mipmaps != MipmapMode::None && image.Levels.size() == 1)
+        std::cout << "Warning: " << m_FilePath << " has no mipmaps, they have to be in the file for compressed textures" << std::endl;
+    
+    BindForUpdate();
+    unsigned long long bytes = 0;
+    for (int level = 0; level < m_MipLevels; level++)
+    {
+        const CompressedImage::Level& info = image.Levels[level];
+        //Goes straight to the GPU as is, no decode
+        GLCall(glCompressedTexImage2D(GL_TEXTURE_2D, level, m_Format, info.Width, info.Height, 0, (GLsizei)info.Size, &image.Data[info.Offset]));
+        bytes += info.Size;
+    }
+    SetMemorySize(bytes);
+    RenderStats::OnTextureUpload(bytes);
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_MipLevels - 1));
+    Unbind();
+    return true;
+}
+
+void Texture::SetSubImage(int x, int y, int width, int height, const void* pixels)
+{
+    //Would need the pixels compressed the same way, and whole blocks at a time
+    if (IsCompressed())
+    {
+        std::cout << "Warning: SetSubImage on compressed texture " << m_FilePath << " ignored" << std::endl;
+        return;
+    }
+    //The rest of the image has to be there to write into
+    if (!m_Resident)
+        Restore();
+    m_SourcePath.clear();
+    BindForUpdate();
+    GLCall(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    if (pixels)
+        RenderStats::OnTextureUpload((unsigned long long)width * height * 4);
+    if (m_MipLevels > 1)
+    {
+        GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+    }
+    Unbind();
 }
 
 void Texture::Bind(unsigned int slot) const
 {
+    //Evicted by TextureResidency, the image has to be back before anything samples it
+    if (!m_Resident)
+    {
+        //The upload goes through unit 0, so put back whatever the caller had bound there, e.g. for Bind(1) mid-frame
+        GLStateCache::ActiveTexture(0);
+        GLint previous = 0;
+        GLCall(glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous));
+        const_cast<Texture*>(this)->Restore();
+        GLStateCache::BindTexture(0, GL_TEXTURE_2D, (unsigned int)previous);
+    }
+    m_LastUsedFrame = TextureResidency::GetFrame();
+    
     //Specify texture slot
-    GLCall(glActiveTexture(GL_TEXTURE0 + slot));
-    GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+    //State cache skips glActiveTexture and glBindTexture when this texture is already bound to slot
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D, m_RendererID);
+    RenderStats::OnTextureBind();
+}
+
+void Texture::BindForUpdate() const
+{
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_RendererID);
+}
+
+void Texture::ReplaceEvicted()
+{
+    if (m_Resident)
+        return;
+    //Whole image is being replaced, so the evicted one isn't needed back, just a name to put the new one in
+    m_EvictedPixels = std::vector<unsigned char>();
+    m_EvictedImage.reset();
+    m_Resident = true;
+    CreateName();
 }
 
-void Texture::Unbind()
+void Texture::Unbind(unsigned int slot)
 {
-    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D, 0);
 }
 
 
@@ -9,6 +9,30 @@
 #define Texture_hpp
 
 #include "Renderer.h"
+#include "CompressedImage.hpp"
+
+#include <memory>
+#include <vector>
+
+enum class MipmapMode
+{
+    //Level 0 only, what every texture used to get
+    None,
+    //glGenerateMipmap, fast but the filter is up to the driver
+    GPU,
+    //2x2 box filter on the CPU (weighted by alpha so transparent pixels don't darken edges), same result on every driver
+    CPUBox
+};
+
+struct TextureOptions
+{
+    MipmapMode Mipmaps = MipmapMode::None;
+    //With mipmaps, blend between the two nearest levels (GL_LINEAR_MIPMAP_LINEAR) instead of picking one
+    bool Trilinear = true;
+    //1 is off, anything higher is clamped to what the driver supports. Needs mipmaps to do much
+    float Anisotropy = 1.0f;
+    unsigned int Wrap = GL_CLAMP_TO_EDGE;
+};
 
 class Texture
 {
@@ -19,17 +43,97 @@ private:
     unsigned char* m_LocalBuffer;
     //BPP = bits per pixel
     int m_Width, m_Height, m_BPP;
+    TextureOptions m_Options;
+    //Levels actually in the texture, 1 without mipmaps
+    int m_MipLevels;
+    //GL_RGBA8, or the block compressed format it was loaded with
+    unsigned int m_Format;
+    //Bytes the image takes on the GPU, every level included. 0 while evicted
+    unsigned long long m_MemorySize;
+    
+    //False once TextureResidency has evicted it, until the next Bind
+    bool m_Resident;
+    //TextureResidency frame this was last bound in, binding doesn't change what the texture looks like so Bind stays const
+    mutable unsigned long long m_LastUsedFrame;
+    //File the current image came straight from, empty once it's been changed from memory
+    //An evicted texture with a source path is reloaded from it, so no copy has to be kept
+    std::string m_SourcePath;
+    //Copy of an evicted texture that didn't come from a file, only one of these is used
+    std::vector<unsigned char> m_EvictedPixels;
+    std::unique_ptr<CompressedImage> m_EvictedImage;
     
 public:
-    Texture(const std::string& path);
+    //.dds and .ktx2 files go up compressed, anything else is decoded to RGBA by stb_image
+    //If the driver can't sample a compressed file's format, the .png next to it is loaded instead
+    Texture(const std::string& path, const TextureOptions& options = TextureOptions());
+    //Uploads the levels as they are. Mipmaps can't be generated for compressed formats, so they're whatever the file has
+    Texture(const CompressedImage& image, const TextureOptions& options = TextureOptions());
+    //Straight from memory, pixels are width * height RGBA bytes (bottom row first) and can be nullptr to leave it empty
+    Texture(int width, int height, const void* pixels, const TextureOptions& options = TextureOptions());
     ~Texture();
     
+    //Replaces the whole image (and rebuilds the mip chain), pixels are RGBA bytes
+    //If a GL_PIXEL_UNPACK_BUFFER is bound, pixels is an offset into it instead of a pointer
+    //CPUBox mipmaps need the pixels in memory, so they fall back to glGenerateMipmap in that case
+    void SetImage(int width, int height, const void* pixels);
+    //Overwrites a width x height rectangle whose bottom left corner is at x, y
+    //Mipmaps are regenerated on the GPU, the CPU filter would need the whole image
+    //Not supported for compressed textures
+    void SetSubImage(int x, int y, int width, int height, const void* pixels);
+    //Replaces the whole image with a compressed one, false if the driver can't sample its format (texture is left as it was)
+    bool SetCompressedImage(const CompressedImage& image);
+    
+    //Changes how the texture is sampled without touching the image
+    void SetSampling(bool trilinear, float anisotropy);
+    //Highest anisotropy the driver allows, 1 if it doesn't have the extension
+    static float GetMaxAnisotropy();
+    
     //Slot is an optional parameter which allwos you to specify the slot you want to bind the texture to
+    //Uploads the image again first if TextureResidency evicted it
     void Bind(unsigned int slot = 0) const;
-    void Unbind();
+    void Unbind(unsigned int slot = 0);
     
     inline int GetWidth() const { return m_Width; }
     inline int GetHeight() const { return m_Height; }
+    inline const std::string& GetFilePath() const { return m_FilePath; }
+    inline const TextureOptions& GetOptions() const { return m_Options; }
+    inline int GetMipLevels() const { return m_MipLevels; }
+    inline unsigned int GetFormat() const { return m_Format; }
+    inline bool IsCompressed() const { return m_Format != GL_RGBA8; }
+    inline unsigned long long GetMemorySize() const { return m_MemorySize; }
+    
+    //Frees the GL storage, keeping a CPU copy if the image can't be read from disk again. Next Bind brings it back
+    void Evict();
+    inline bool IsResident() const { return m_Resident; }
+    inline unsigned long long GetLastUsedFrame() const { return m_LastUsedFrame; }
+    //The file the current image was loaded from, for images uploaded with SetImage after reading a file (TextureLoader)
+    inline void SetSourcePath(const std::string& path) { m_SourcePath = path; }
+    
+    //Levels a full chain for this size has, down to 1x1
+    static int GetMipLevelCount(int width, int height);
+    //Next mip level of an RGBA image with the same filter CPUBox uses, dst holds max(1, width / 2) x max(1, height / 2) pixels
+    static void Downsample(const unsigned char* src, int width, int height, unsigned char* dst);
+private:
+    //Creates the GL texture and sets up sampling, no image yet
+    void Create();
+    //Just the GL name and sampling, Create and Restore share it
+    void CreateName();
+    //Binds to slot 0 and makes it the active unit for changing (or reading back) the texture, without any of Bind's residency or stats
+    void BindForUpdate() const;
+    //Uploads an evicted texture again
+    void Restore();
+    //For functions replacing the whole image, gives an evicted texture a new GL name without bringing the old image back
+    void ReplaceEvicted();
+    //Keeps m_MemorySize and the memory stats in step
+    void SetMemorySize(unsigned long long bytes);
+    //Reads and uploads a .dds or .ktx2, false if the file is broken or the driver can't sample its format
+    bool LoadCompressed(const std::string& path);
+    //Anything else, decoded to RGBA by stb_image
+    void LoadImage(const std::string& path);
+    //Filters and wrap from m_Options, texture has to be bound
+    void ApplySampling();
+    //Builds and uploads levels 1 and up from level 0's pixels, texture has to be bound
+    void UploadCPUMips(const unsigned char* pixels);
 };
 
 #endif /* Texture_hpp */
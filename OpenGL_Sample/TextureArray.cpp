@@ -0,0 +1,183 @@
+//
+//  TextureArray.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TextureArray.hpp"
+#include "CPUProfiler.hpp"
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
+
+#include "stb_image/stb_image.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+TextureArray::TextureArray(int width, int height, int layers, const TextureOptions& options)
+    : m_RendererID(0), m_Width(width), m_Height(height), m_Layers(layers), m_Options(options), m_MipLevels(1),
+      m_MemorySize(0), m_MipmapsDirty(false)
+{
+    CPU_PROFILE_FUNCTION();
+    if (m_Layers > GetMaxLayers())
+    {
+        std::cout << "Warning: " << layers << " layers asked for, this driver only allows " << GetMaxLayers() << std::endl;
+        m_Layers = GetMaxLayers();
+    }
+    if (m_Options.Mipmaps != MipmapMode::None)
+        m_MipLevels = Texture::GetMipLevelCount(width, height);
+    
+    GLCall(glGenTextures(1, &m_RendererID));
+    BindForUpdate();
+    ApplySampling();
+    
+    //No glTexStorage3D before GL 4.2, so each level is allocated on its own
+    //Layers nobody sets should come out transparent rather than whatever the driver had lying around, so each one is
+    //cleared from a single layer of zeroes. Zeroing the whole array at once could take over a GB of host memory
+    std::vector<unsigned char> zeroes((size_t)width * height * 4);
+    for (int level = 0; level < m_MipLevels; level++)
+    {
+        int levelWidth = std::max(1, width >> level);
+        int levelHeight = std::max(1, height >> level);
+        GLCall(glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, levelWidth, levelHeight, m_Layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+        for (int layer = 0; layer < m_Layers; layer++)
+        {
+            GLCall(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, levelWidth, levelHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE, zeroes.data()));
+        }
+        m_MemorySize += (unsigned long long)levelWidth * levelHeight * m_Layers * 4;
+    }
+    GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, m_MipLevels - 1));
+    Unbind();
+    
+    RenderStats::OnObjectCreated(GLObjectType::Texture);
+    RenderStats::OnMemoryAllocated(GLObjectType::Texture, m_MemorySize);
+}
+
+TextureArray::~TextureArray()
+{
+    GLCall(glDeleteTextures(1, &m_RendererID));
+    GLStateCache::OnTextureDeleted(m_RendererID);
+    RenderStats::OnMemoryFreed(GLObjectType::Texture, m_MemorySize);
+    RenderStats::OnObjectDestroyed(GLObjectType::Texture);
+}
+
+int TextureArray::GetMaxLayers()
+{
+    //-1 until the first call, glGet needs a current context
+    static int maxLayers = -1;
+    if (maxLayers < 0)
+    {
+        GLCall(glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers));
+    }
+    return maxLayers;
+}
+
+void TextureArray::ApplySampling()
+{
+    //Same filters as Texture, see Texture::ApplySampling
+    GLenum minFilter = GL_LINEAR;
+    if (m_Options.Mipmaps != MipmapMode::None)
+        minFilter = m_Options.Trilinear ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_NEAREST;
+    GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, minFilter));
+    GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, m_Options.Wrap));
+    GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, m_Options.Wrap));
+    
+    float maxAnisotropy = Texture::GetMaxAnisotropy();
+    if (maxAnisotropy > 1.0f)
+    {
+        GLCall(glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY_EXT, std::min(std::max(m_Options.Anisotropy, 1.0f), maxAnisotropy)));
+    }
+}
+
+void TextureArray::UploadCPUMips(int layer, const unsigned char* pixels)
+{
+    CPU_PROFILE_FUNCTION();
+    const unsigned char* src = pixels;
+    int width = m_Width, height = m_Height;
+    std::vector<unsigned char> levels[2];
+    unsigned long long bytes = 0;
+    for (int level = 1; level < m_MipLevels; level++)
+    {
+        int levelWidth = std::max(1, width / 2);
+        int levelHeight = std::max(1, height / 2);
+        std::vector<unsigned char>& dst = levels[level % 2];
+        dst.resize((size_t)levelWidth * levelHeight * 4);
+        Texture::Downsample(src, width, height, dst.data());
+        GLCall(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, levelWidth, levelHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE, dst.data()));
+        bytes += dst.size();
+        
+        src = dst.data();
+        width = levelWidth;
+        height = levelHeight;
+    }
+    RenderStats::OnTextureUpload(bytes);
+}
+
+void TextureArray::SetLayer(int layer, const void* pixels)
+{
+    if (!pixels)
+        return;
+    if (layer < 0 || layer >= m_Layers)
+    {
+        std::cout << "Warning: TextureArray::SetLayer(" << layer << ") ignored, the array has " << m_Layers << " layers" << std::endl;
+        return;
+    }
+    
+    BindForUpdate();
+    //Depth of 1 at z = layer, only touches that one layer
+    GLCall(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, m_Width, m_Height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    RenderStats::OnTextureUpload((unsigned long long)m_Width * m_Height * 4);
+    
+    if (m_Options.Mipmaps == MipmapMode::CPUBox)
+        UploadCPUMips(layer, (const unsigned char*)pixels);
+    else if (m_Options.Mipmaps == MipmapMode::GPU)
+        m_MipmapsDirty = true;
+    Unbind();
+}
+
+bool TextureArray::LoadLayer(int layer, const std::string& path)
+{
+    CPU_PROFILE_FUNCTION();
+    int width = 0, height = 0, bpp = 0;
+    stbi_set_flip_vertically_on_load(1);
+    unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &bpp, 4);
+    if (!pixels)
+    {
+        std::cout << "Failed to load " << path << " into a TextureArray" << std::endl;
+        return false;
+    }
+    //Scaling it to fit would be a surprise, better to hear about it
+    bool fits = width == m_Width && height == m_Height;
+    if (fits)
+        SetLayer(layer, pixels);
+    else
+        std::cout << "Warning: " << path << " is " << width << "x" << height << " but the TextureArray's layers are "
+            << m_Width << "x" << m_Height << std::endl;
+    stbi_image_free(pixels);
+    return fits;
+}
+
+void TextureArray::Bind(unsigned int slot) const
+{
+    if (m_MipmapsDirty)
+    {
+        BindForUpdate();
+        GLCall(glGenerateMipmap(GL_TEXTURE_2D_ARRAY));
+        m_MipmapsDirty = false;
+    }
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D_ARRAY, m_RendererID);
+    RenderStats::OnTextureBind();
+}
+
+void TextureArray::BindForUpdate() const
+{
+    GLStateCache::BindTexture(0, GL_TEXTURE_2D_ARRAY, m_RendererID);
+}
+
+void TextureArray::Unbind(unsigned int slot)
+{
+    GLStateCache::BindTexture(slot, GL_TEXTURE_2D_ARRAY, 0);
+}
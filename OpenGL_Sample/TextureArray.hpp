@@ -0,0 +1,64 @@
+//
+//  TextureArray.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TextureArray_hpp
+#define TextureArray_hpp
+
+#include <string>
+
+#include "Renderer.h"
+#include "Texture.hpp"
+
+//Many same sized images stored as the layers of one GL_TEXTURE_2D_ARRAY
+//The shader picks the layer per vertex (BatchVertex::Layer, basic.shader with TEXTURE_ARRAY defined),
+//so quads using different images still go in the same batch, with one bind and no limit of 16 texture units
+//Unlike a TextureAtlas nothing bleeds between images and wrapping works, but every layer has to be the same size
+//Not managed by TextureResidency, the whole array is resident for as long as it exists
+class TextureArray
+{
+private:
+    unsigned int m_RendererID;
+    int m_Width, m_Height;
+    int m_Layers;
+    TextureOptions m_Options;
+    int m_MipLevels;
+    //Every level of every layer, allocated up front
+    unsigned long long m_MemorySize;
+    //GPU mipmaps are rebuilt for the whole array at once, so they wait for the next Bind instead of happening once per layer
+    mutable bool m_MipmapsDirty;
+public:
+    //Layers start out empty (black and transparent). Clamped to GL_MAX_ARRAY_TEXTURE_LAYERS
+    TextureArray(int width, int height, int layers, const TextureOptions& options = TextureOptions());
+    ~TextureArray();
+    
+    //pixels are width * height RGBA bytes, bottom row first like Texture. Nothing happens if it is nullptr
+    void SetLayer(int layer, const void* pixels);
+    //Decoded by stb_image, false if the file can't be read or isn't exactly width x height (the layer is left as it was)
+    bool LoadLayer(int layer, const std::string& path);
+    
+    //Builds any mipmaps that are out of date first
+    void Bind(unsigned int slot = 0) const;
+    void Unbind(unsigned int slot = 0);
+    
+    inline int GetWidth() const { return m_Width; }
+    inline int GetHeight() const { return m_Height; }
+    inline int GetLayerCount() const { return m_Layers; }
+    inline int GetMipLevels() const { return m_MipLevels; }
+    inline unsigned long long GetMemorySize() const { return m_MemorySize; }
+    
+    //Most layers the driver allows in one array, at least 256 on GL 3.3
+    static int GetMaxLayers();
+private:
+    //Binds to slot 0 for changing the texture, without Bind's mipmaps or stats
+    void BindForUpdate() const;
+    //Filters and wrap from m_Options, texture has to be bound
+    void ApplySampling();
+    //Same filter as Texture's CPUBox, for one layer. Texture has to be bound
+    void UploadCPUMips(int layer, const unsigned char* pixels);
+};
+
+#endif /* TextureArray_hpp */
@@ -0,0 +1,152 @@
+//
+//  TextureAtlas.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TextureAtlas.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "stb_image/stb_image.h"
+
+//imgui_draw.cpp compiles its own static copy, so this one has to be static too
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imgui/imstb_rectpack.h"
+
+struct TextureAtlas::Page
+{
+    std::unique_ptr<Texture> PageTexture;
+    stbrp_context Context;
+    std::vector<stbrp_node> Nodes;
+};
+
+TextureAtlas::TextureAtlas(int pageSize, int padding)
+    : m_PageSize(pageSize), m_Padding(padding), m_RepackCount(0)
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+}
+
+int TextureAtlas::Add(const std::string& path)
+{
+    //Same orientation as Texture so UVs come out the same way round
+    stbi_set_flip_vertically_on_load(1);
+    int width = 0, height = 0, bpp = 0;
+    unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &bpp, 4);
+    if (!pixels)
+    {
+        std::cout << "Warning: failed to load atlas image " << path << std::endl;
+        return -1;
+    }
+    int id = Add(width, height, pixels);
+    stbi_image_free(pixels);
+    return id;
+}
+
+int TextureAtlas::Add(int width, int height, const unsigned char* pixels)
+{
+    if (width + m_Padding > m_PageSize || height + m_Padding > m_PageSize)
+    {
+        std::cout << "Warning: " << width << "x" << height << " image doesn't fit in a " << m_PageSize << " atlas page" << std::endl;
+        return -1;
+    }
+    
+    Image image;
+    image.Pixels.assign(pixels, pixels + width * height * 4);
+    image.Width = width;
+    image.Height = height;
+    m_Images.push_back(std::move(image));
+    
+    //Fast path, squeeze it in somewhere
+    if (Insert(m_Images.back()))
+        return (int)m_Images.size() - 1;
+    
+    //Pages are fragmented or full, a fresh pack of everything will also make a new page if it really needs one
+    Repack();
+    return (int)m_Images.size() - 1;
+}
+
+bool TextureAtlas::Insert(Image& image)
+{
+    stbrp_rect rect = {};
+    rect.w = image.Width + m_Padding;
+    rect.h = image.Height + m_Padding;
+    for (unsigned int i = 0; i < m_Pages.size(); i++)
+    {
+        //Packer keeps its skyline between calls, so packing one more rect into a page is cheap
+        if (stbrp_pack_rects(&m_Pages[i]->Context, &rect, 1) && rect.was_packed)
+        {
+            Upload(*m_Pages[i], i, image, rect.x, rect.y);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TextureAtlas::Repack()
+{
+    m_Pages.clear();
+    m_RepackCount++;
+    
+    std::vector<stbrp_rect> rects(m_Images.size());
+    for (unsigned int i = 0; i < m_Images.size(); i++)
+    {
+        rects[i] = {};
+        rects[i].id = (int)i;
+        rects[i].w = m_Images[i].Width + m_Padding;
+        rects[i].h = m_Images[i].Height + m_Padding;
+    }
+    
+    //Fill one page at a time with whatever is left over from the previous one
+    while (!rects.empty())
+    {
+        unsigned int pageIndex = (unsigned int)m_Pages.size();
+        Page& page = AddPage();
+        //Packer sorts by height internally and puts the rects back in their original order afterwards
+        stbrp_pack_rects(&page.Context, rects.data(), (int)rects.size());
+        
+        std::vector<stbrp_rect> leftover;
+        for (const stbrp_rect& rect : rects)
+        {
+            if (rect.was_packed)
+                Upload(page, pageIndex, m_Images[rect.id], rect.x, rect.y);
+            else
+                leftover.push_back(rect);
+        }
+        rects.swap(leftover);
+    }
+}
+
+TextureAtlas::Page& TextureAtlas::AddPage()
+{
+    std::unique_ptr<Page> page = std::make_unique<Page>();
+    //Zeroed so the padding between images is transparent
+    std::vector<unsigned char> empty(m_PageSize * m_PageSize * 4, 0);
+    page->PageTexture = std::make_unique<Texture>(m_PageSize, m_PageSize, empty.data());
+    //stb recommends one node per pixel of width for the best packing
+    page->Nodes.resize(m_PageSize);
+    stbrp_init_target(&page->Context, m_PageSize, m_PageSize, page->Nodes.data(), (int)page->Nodes.size());
+    m_Pages.push_back(std::move(page));
+    return *m_Pages.back();
+}
+
+void TextureAtlas::Upload(Page& page, unsigned int pageIndex, Image& image, int x, int y)
+{
+    page.PageTexture->SetSubImage(x, y, image.Width, image.Height, image.Pixels.data());
+    
+    float size = (float)m_PageSize;
+    image.Region.Page = pageIndex;
+    image.Region.UVMin = glm::vec2(x / size, y / size);
+    image.Region.UVMax = glm::vec2((x + image.Width) / size, (y + image.Height) / size);
+}
+
+const Texture& TextureAtlas::GetPage(unsigned int page) const
+{
+    return *m_Pages[page]->PageTexture;
+}
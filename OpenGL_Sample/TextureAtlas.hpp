@@ -0,0 +1,79 @@
+//
+//  TextureAtlas.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TextureAtlas_hpp
+#define TextureAtlas_hpp
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Texture.hpp"
+
+//Where an image ended up inside the atlas
+struct AtlasRegion
+{
+    //Which page texture to bind
+    unsigned int Page = 0;
+    //Texture coordinates of the image's corners on that page, bottom left and top right
+    glm::vec2 UVMin = glm::vec2(0.0f);
+    glm::vec2 UVMax = glm::vec2(0.0f);
+};
+
+//Packs lots of small images into a few big page textures (using the rect packer that ships with ImGui)
+//Everything on one page can be drawn in a single batch with a single texture bind,
+//instead of one bind and one draw call per image
+//
+//Add packs incrementally into the existing pages. When an image doesn't fit anywhere the whole atlas
+//gets repacked from scratch (tallest first, which packs a lot tighter) before resorting to a new page.
+//Repacking moves images around, so look regions up again with GetRegion instead of holding on to them
+class TextureAtlas
+{
+private:
+    struct Image
+    {
+        //Kept on the CPU so the atlas can be repacked
+        std::vector<unsigned char> Pixels;
+        int Width, Height;
+        AtlasRegion Region;
+    };
+    struct Page;
+    
+    int m_PageSize;
+    //Empty pixels left between images so linear filtering doesn't bleed neighbours into each other
+    int m_Padding;
+    std::vector<Image> m_Images;
+    //Pointers because the packer's context points into itself and can't be moved around
+    std::vector<std::unique_ptr<Page>> m_Pages;
+    unsigned int m_RepackCount;
+public:
+    TextureAtlas(int pageSize = 2048, int padding = 1);
+    ~TextureAtlas();
+    
+    //Both return an id for GetRegion, or -1 if the image couldn't be loaded or is bigger than a page
+    int Add(const std::string& path);
+    //pixels are width * height RGBA bytes, bottom row first like Texture
+    int Add(int width, int height, const unsigned char* pixels);
+    
+    //Throws all pages away and packs every image again
+    void Repack();
+    
+    inline const AtlasRegion& GetRegion(int id) const { return m_Images[id].Region; }
+    const Texture& GetPage(unsigned int page) const;
+    inline unsigned int GetPageCount() const { return (unsigned int)m_Pages.size(); }
+    inline unsigned int GetImageCount() const { return (unsigned int)m_Images.size(); }
+    inline unsigned int GetRepackCount() const { return m_RepackCount; }
+private:
+    //Tries to fit the image into an existing page, returns false if there's no room anywhere
+    bool Insert(Image& image);
+    Page& AddPage();
+    void Upload(Page& page, unsigned int pageIndex, Image& image, int x, int y);
+};
+
+#endif /* TextureAtlas_hpp */
@@ -0,0 +1,151 @@
+//
+//  TextureCache.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TextureCache.hpp"
+#include "CPUProfiler.hpp"
+#include "TextureLoader.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+TextureCache::TextureCache(unsigned long long retainBudget)
+    : m_RetainBudget(retainBudget), m_NextSweep(16)
+{
+}
+
+TextureCache& TextureCache::Get()
+{
+    static TextureCache cache;
+    return cache;
+}
+
+std::string TextureCache::MakeKey(const std::string& path, const TextureOptions& options)
+{
+    //Resolves .., symlinks and the like for the parts of the path that exist
+    std::error_code error;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+    std::string key = error ? std::filesystem::path(path).lexically_normal().string() : canonical.string();
+    
+    key += '|' + std::to_string((int)options.Mipmaps) + (options.Trilinear ? "t" : "n") + std::to_string(options.Anisotropy) + '|' + std::to_string(options.Wrap);
+    return key;
+}
+
+template<typename F>
+std::shared_ptr<Texture> TextureCache::GetOrCreate(const std::string& path, const TextureOptions& options, F create)
+{
+    std::string key = MakeKey(path, options);
+    auto cached = m_Textures.find(key);
+    if (cached != m_Textures.end())
+    {
+        if (std::shared_ptr<Texture> texture = cached->second.lock())
+        {
+            m_Stats.Hits++;
+            m_Stats.SavedBytes += texture->GetMemorySize();
+            Retain(texture);
+            return texture;
+        }
+        //Was loaded once but everyone let go, about to be replaced below
+        m_Stats.Evictions++;
+    }
+    
+    m_Stats.Misses++;
+    std::shared_ptr<Texture> texture = create();
+    m_Textures[key] = texture;
+    Retain(texture);
+    
+    //Only now and then, most misses don't leave anything to sweep
+    if (m_Textures.size() >= m_NextSweep)
+    {
+        Prune();
+        m_NextSweep = std::max<size_t>(16, m_Textures.size() * 2);
+    }
+    return texture;
+}
+
+std::shared_ptr<Texture> TextureCache::Load(const std::string& path, const TextureOptions& options)
+{
+    CPU_PROFILE_FUNCTION();
+    return GetOrCreate(path, options, [&]() { return std::make_shared<Texture>(path, options); });
+}
+
+std::shared_ptr<Texture> TextureCache::LoadAsync(const std::string& path, const TextureOptions& options)
+{
+    CPU_PROFILE_FUNCTION();
+    return GetOrCreate(path, options, [&]() { return TextureLoader::Get().Load(path, options); });
+}
+
+void TextureCache::Retain(const std::shared_ptr<Texture>& texture)
+{
+    auto existing = std::find(m_Retained.begin(), m_Retained.end(), texture);
+    if (existing != m_Retained.end())
+        m_Retained.splice(m_Retained.begin(), m_Retained, existing);
+    else
+        m_Retained.push_front(texture);
+    TrimRetained();
+}
+
+void TextureCache::TrimRetained()
+{
+    //Sizes are checked every time, textures from LoadAsync only get their real size once the image arrives
+    unsigned long long bytes = 0;
+    for (auto it = m_Retained.begin(); it != m_Retained.end();)
+    {
+        bytes += (*it)->GetMemorySize();
+        //Newest one always stays (unless retaining is off), even if it's bigger than the whole budget on its own
+        if (bytes > m_RetainBudget && (it != m_Retained.begin() || m_RetainBudget == 0))
+            it = m_Retained.erase(it);
+        else
+            it++;
+    }
+}
+
+unsigned int TextureCache::Prune()
+{
+    unsigned int pruned = 0;
+    for (auto it = m_Textures.begin(); it != m_Textures.end();)
+    {
+        if (it->second.expired())
+        {
+            it = m_Textures.erase(it);
+            pruned++;
+        }
+        else
+            it++;
+    }
+    m_Stats.Evictions += pruned;
+    return pruned;
+}
+
+void TextureCache::Clear()
+{
+    m_Retained.clear();
+    m_Textures.clear();
+    m_NextSweep = 16;
+}
+
+void TextureCache::SetRetainBudget(unsigned long long bytes)
+{
+    m_RetainBudget = bytes;
+    TrimRetained();
+}
+
+unsigned long long TextureCache::GetRetainedBytes() const
+{
+    unsigned long long bytes = 0;
+    for (const std::shared_ptr<Texture>& texture : m_Retained)
+        bytes += texture->GetMemorySize();
+    return bytes;
+}
+
+unsigned int TextureCache::GetLiveCount() const
+{
+    unsigned int live = 0;
+    for (const auto& entry : m_Textures)
+        if (!entry.second.expired())
+            live++;
+    return live;
+}
@@ -0,0 +1,80 @@
+//
+//  TextureCache.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TextureCache_hpp
+#define TextureCache_hpp
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Texture.hpp"
+
+struct TextureCacheStats
+{
+    unsigned int Hits = 0;
+    unsigned int Misses = 0;
+    //Entries dropped because every owner (and the retain list) had let go of the texture
+    unsigned int Evictions = 0;
+    //Bytes hits didn't have to decode and upload again
+    unsigned long long SavedBytes = 0;
+    
+    inline float GetHitRate() const { return Hits + Misses ? (float)Hits / (Hits + Misses) : 0.0f; }
+};
+
+//Hands out shared textures so the same file is only ever decoded and uploaded once
+//  - Keyed by canonical path plus the TextureOptions, so "res/../res/a.png" and "res/a.png" are the same texture,
+//    but the same file with different mipmaps or wrapping isn't
+//  - Only holds weak references, a texture goes away once nobody uses it and its entry is swept on a later miss
+//  - Except the most recently used ones, kept alive up to a byte budget so closing a scene and opening it
+//    again (or the next scene using the same files) doesn't reload anything
+//Everything here happens on the GL thread. Textures from the cache are shared, so don't SetSampling or SetImage them
+class TextureCache
+{
+private:
+    std::unordered_map<std::string, std::weak_ptr<Texture>> m_Textures;
+    //Most recently used first
+    std::list<std::shared_ptr<Texture>> m_Retained;
+    unsigned long long m_RetainBudget;
+    //Map size that triggers the next sweep, grows with the number of live textures so sweeping stays cheap
+    size_t m_NextSweep;
+    TextureCacheStats m_Stats;
+public:
+    TextureCache(unsigned long long retainBudget = 64 * 1024 * 1024);
+    
+    //Shared instance the scenes use
+    static TextureCache& Get();
+    
+    //Loads right away on a miss
+    std::shared_ptr<Texture> Load(const std::string& path, const TextureOptions& options = TextureOptions());
+    //Goes through TextureLoader on a miss, so it might still be the placeholder. A hit might be too if the first load hasn't finished
+    std::shared_ptr<Texture> LoadAsync(const std::string& path, const TextureOptions& options = TextureOptions());
+    
+    //Drops entries for textures that are gone, returns how many
+    unsigned int Prune();
+    //Forgets everything, textures still in use stay alive with their owners
+    //main.cpp calls it before the context goes away, since the retained textures are GL objects
+    void Clear();
+    
+    //0 keeps nothing alive beyond its owners
+    void SetRetainBudget(unsigned long long bytes);
+    unsigned long long GetRetainedBytes() const;
+    unsigned int GetLiveCount() const;
+    inline const TextureCacheStats& GetStats() const { return m_Stats; }
+    inline void ResetStats() { m_Stats = TextureCacheStats(); }
+private:
+    //Shared by both loads, create only runs on a miss
+    template<typename F>
+    std::shared_ptr<Texture> GetOrCreate(const std::string& path, const TextureOptions& options, F create);
+    //Moves texture to the front of the retain list, then lets go of the oldest ones past the budget
+    void Retain(const std::shared_ptr<Texture>& texture);
+    void TrimRetained();
+    static std::string MakeKey(const std::string& path, const TextureOptions& options);
+};
+
+#endif /* TextureCache_hpp */
@@ -0,0 +1,521 @@
+//
+//  TextureCompressor.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TextureCompressor.hpp"
+#include "Texture.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "stb_image/stb_image.h"
+
+static uint16_t Pack565(const float color[3])
+{
+    int r = (int)std::lround(std::min(std::max(color[0], 0.0f), 255.0f) * 31.0f / 255.0f);
+    int g = (int)std::lround(std::min(std::max(color[1], 0.0f), 255.0f) * 63.0f / 255.0f);
+    int b = (int)std::lround(std::min(std::max(color[2], 0.0f), 255.0f) * 31.0f / 255.0f);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+//Same expansion the GPU does, top bits repeated into the bottom ones
+static void Unpack565(uint16_t packed, int color[3])
+{
+    int r = packed >> 11, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+//Best of the four palette entries c0 and c1 make for every pixel, 2 bits each with pixel 0 in the lowest bits
+//Returns the total squared error, pixels with no weight (transparent ones in BC3) don't count
+static int FitIndices(const unsigned char* pixels, const int weights[16], uint16_t c0, uint16_t c1, uint32_t& indices)
+{
+    int palette[4][3];
+    Unpack565(c0, palette[0]);
+    Unpack565(c1, palette[1]);
+    for (int c = 0; c < 3; c++)
+    {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+    }
+    
+    indices = 0;
+    int error = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        int best = 0, bestError = INT_MAX;
+        for (int p = 0; p < 4; p++)
+        {
+            int distance = 0;
+            for (int c = 0; c < 3; c++)
+            {
+                int difference = pixels[i * 4 + c] - palette[p][c];
+                distance += difference * difference;
+            }
+            if (distance < bestError)
+            {
+                best = p;
+                bestError = distance;
+            }
+        }
+        indices |= (uint32_t)best << (i * 2);
+        error += bestError * weights[i];
+    }
+    return error;
+}
+
+//Endpoints that minimise the squared error for indices that are already chosen, false if every pixel uses the same one
+static bool RefineEndpoints(const unsigned char* pixels, const int weights[16], uint32_t indices, float e0[3], float e1[3])
+{
+    //How much of c0 each index is made of
+    static const float s_Blend[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    float ax[3] = { 0.0f, 0.0f, 0.0f }, bx[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; i++)
+    {
+        if (!weights[i])
+            continue;
+        float a = s_Blend[(indices >> (i * 2)) & 3];
+        float b = 1.0f - a;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (int c = 0; c < 3; c++)
+        {
+            ax[c] += a * pixels[i * 4 + c];
+            bx[c] += b * pixels[i * 4 + c];
+        }
+    }
+    float determinant = aa * bb - ab * ab;
+    if (std::fabs(determinant) < 1e-6f)
+        return false;
+    for (int c = 0; c < 3; c++)
+    {
+        e0[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+        e1[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+    }
+    return true;
+}
+
+//8 byte BC1 color block, only pixels with weight shape the endpoints
+static void EncodeColor(const unsigned char* pixels, const int weights[16], unsigned char* block)
+{
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    int total = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        for (int c = 0; c < 3; c++)
+            mean[c] += pixels[i * 4 + c] * weights[i];
+        total += weights[i];
+    }
+    for (int c = 0; c < 3; c++)
+        mean[c] /= total;
+    
+    //Colors in a small block mostly lie along one line, find it with a few rounds of power iteration on the covariance
+    float covariance[3][3] = {};
+    for (int i = 0; i < 16; i++)
+    {
+        if (!weights[i])
+            continue;
+        float d[3] = { pixels[i * 4] - mean[0], pixels[i * 4 + 1] - mean[1], pixels[i * 4 + 2] - mean[2] };
+        for (int row = 0; row < 3; row++)
+            for (int column = 0; column < 3; column++)
+                covariance[row][column] += d[row] * d[column];
+    }
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        float next[3];
+        for (int row = 0; row < 3; row++)
+            next[row] = covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2];
+        float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+        //Flat block, any axis will do
+        if (length < 1e-4f)
+            break;
+        for (int c = 0; c < 3; c++)
+            axis[c] = next[c] / length;
+    }
+    
+    //Ends of the line the pixels cover
+    float lowest = FLT_MAX, highest = -FLT_MAX;
+    for (int i = 0; i < 16; i++)
+    {
+        if (!weights[i])
+            continue;
+        float t = 0.0f;
+        for (int c = 0; c < 3; c++)
+            t += (pixels[i * 4 + c] - mean[c]) * axis[c];
+        lowest = std::min(lowest, t);
+        highest = std::max(highest, t);
+    }
+    float e0[3], e1[3];
+    for (int c = 0; c < 3; c++)
+    {
+        e0[c] = mean[c] + axis[c] * highest;
+        e1[c] = mean[c] + axis[c] * lowest;
+    }
+    
+    uint16_t c0 = Pack565(e0), c1 = Pack565(e1);
+    uint32_t indices = 0;
+    int error = FitIndices(pixels, weights, c0, c1, indices);
+    //Bounding the line is a good start, least squares on the chosen indices usually shaves a bit more off
+    if (RefineEndpoints(pixels, weights, indices, e0, e1))
+    {
+        uint16_t r0 = Pack565(e0), r1 = Pack565(e1);
+        uint32_t refined = 0;
+        int refinedError = FitIndices(pixels, weights, r0, r1, refined);
+        if (refinedError < error)
+        {
+            c0 = r0;
+            c1 = r1;
+            indices = refined;
+        }
+    }
+    
+    //c0 > c1 picks the 4 color mode, swapping the endpoints swaps index 0 with 1 and 2 with 3
+    if (c0 < c1)
+    {
+        std::swap(c0, c1);
+        indices ^= 0x55555555;
+    }
+    else if (c0 == c1)
+        indices = 0;
+    memcpy(block, &c0, 2);
+    memcpy(block + 2, &c1, 2);
+    memcpy(block + 4, &indices, 4);
+}
+
+//8 byte BC3 alpha block, a0 > a1 gives 6 steps between them
+static void EncodeAlpha(const unsigned char* pixels, unsigned char* block)
+{
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; i++)
+    {
+        a0 = std::max(a0, (int)pixels[i * 4 + 3]);
+        a1 = std::min(a1, (int)pixels[i * 4 + 3]);
+    }
+    block[0] = (unsigned char)a0;
+    block[1] = (unsigned char)a1;
+    
+    //All the same, index 0 everywhere
+    uint64_t bits = 0;
+    if (a0 != a1)
+    {
+        int palette[8] = { a0, a1 };
+        for (int k = 2; k < 8; k++)
+            palette[k] = ((8 - k) * a0 + (k - 1) * a1 + 3) / 7;
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0, bestError = INT_MAX;
+            for (int p = 0; p < 8; p++)
+            {
+                int difference = std::abs(pixels[i * 4 + 3] - palette[p]);
+                if (difference < bestError)
+                {
+                    best = p;
+                    bestError = difference;
+                }
+            }
+            bits |= (uint64_t)best << (i * 3);
+        }
+    }
+    memcpy(block + 2, &bits, 6);
+}
+
+void TextureCompressor::EncodeBC1Block(const unsigned char* pixels, unsigned char* block)
+{
+    static const int s_Weights[16] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+    EncodeColor(pixels, s_Weights, block);
+}
+
+void TextureCompressor::EncodeBC3Block(const unsigned char* pixels, unsigned char* block)
+{
+    EncodeAlpha(pixels, block);
+    
+    //What's under a fully transparent pixel doesn't matter, unless that's the whole block
+    int weights[16];
+    int total = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        weights[i] = pixels[i * 4 + 3] ? 1 : 0;
+        total += weights[i];
+    }
+    if (!total)
+        std::fill(weights, weights + 16, 1);
+    EncodeColor(pixels, weights, block + 8);
+}
+
+CompressedImage TextureCompressor::Compress(const unsigned char* pixels, int width, int height, bool mipmaps)
+{
+    bool opaque = true;
+    for (size_t i = 0; i < (size_t)width * height && opaque; i++)
+        opaque = pixels[i * 4 + 3] == 255;
+    
+    CompressedImage image;
+    image.Format = opaque ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    image.Width = width;
+    image.Height = height;
+    image.AllocateLevels(mipmaps ? Texture::GetMipLevelCount(width, height) : 1);
+    unsigned int blockSize = CompressedImage::GetBlockSize(image.Format);
+    
+    std::vector<unsigned char> level(pixels, pixels + (size_t)width * height * 4);
+    std::vector<unsigned char> next;
+    for (const CompressedImage::Level& info : image.Levels)
+    {
+        unsigned char* block = &image.Data[info.Offset];
+        for (int by = 0; by < info.Height; by += 4)
+        {
+            for (int bx = 0; bx < info.Width; bx += 4)
+            {
+                //Blocks hanging off the edge repeat the last row and column
+                unsigned char texels[16 * 4];
+                for (int y = 0; y < 4; y++)
+                    for (int x = 0; x < 4; x++)
+                        memcpy(&texels[(y * 4 + x) * 4], &level[((size_t)std::min(by + y, info.Height - 1) * info.Width + std::min(bx + x, info.Width - 1)) * 4], 4);
+                if (opaque)
+                    EncodeBC1Block(texels, block);
+                else
+                    EncodeBC3Block(texels, block);
+                block += blockSize;
+            }
+        }
+        
+        next.resize((size_t)std::max(1, info.Width / 2) * std::max(1, info.Height / 2) * 4);
+        Texture::Downsample(level.data(), info.Width, info.Height, next.data());
+        level.swap(next);
+    }
+    return image;
+}
+
+static void PutU32(std::vector<unsigned char>& out, uint32_t value)
+{
+    unsigned char bytes[4];
+    memcpy(bytes, &value, 4);
+    out.insert(out.end(), bytes, bytes + 4);
+}
+
+static void PutU64(std::vector<unsigned char>& out, uint64_t value)
+{
+    unsigned char bytes[8];
+    memcpy(bytes, &value, 8);
+    out.insert(out.end(), bytes, bytes + 8);
+}
+
+static bool WriteFile(const std::string& path, const std::vector<unsigned char>& contents)
+{
+    std::ofstream stream(path, std::ios::binary);
+    if (!stream.write((const char*)contents.data(), contents.size()))
+    {
+        std::cout << "Failed to write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool IsBC1OrBC3(const std::string& path, unsigned int format)
+{
+    if (format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT || format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+        return true;
+    std::cout << "Can't write " << CompressedImage::GetFormatName(format) << " to " << path << ", only BC1 and BC3" << std::endl;
+    return false;
+}
+
+bool TextureCompressor::WriteDDS(const std::string& path, const CompressedImage& source)
+{
+    if (!IsBC1OrBC3(path, source.Format))
+        return false;
+    //DDS has no way to say the rows go up
+    CompressedImage image = source;
+    if (image.BottomUp)
+        image.FlipVertically();
+    
+    std::vector<unsigned char> out = { 'D', 'D', 'S', ' ' };
+    PutU32(out, 124);
+    //CAPS | HEIGHT | WIDTH | PIXELFORMAT | MIPMAPCOUNT | LINEARSIZE
+    PutU32(out, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000);
+    PutU32(out, (uint32_t)image.Height);
+    PutU32(out, (uint32_t)image.Width);
+    PutU32(out, (uint32_t)image.Levels[0].Size);
+    PutU32(out, 0);
+    PutU32(out, (uint32_t)image.Levels.size());
+    for (int i = 0; i < 11; i++)
+        PutU32(out, 0);
+    
+    //Pixel format, just a FourCC
+    PutU32(out, 32);
+    PutU32(out, 0x4);
+    out.insert(out.end(), { 'D', 'X', 'T', image.Format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? (unsigned char)'1' : (unsigned char)'5' });
+    for (int i = 0; i < 5; i++)
+        PutU32(out, 0);
+    
+    //TEXTURE, plus COMPLEX | MIPMAP when there's a chain
+    PutU32(out, 0x1000 | (image.Levels.size() > 1 ? 0x8 | 0x400000 : 0));
+    for (int i = 0; i < 4; i++)
+        PutU32(out, 0);
+    
+    out.insert(out.end(), image.Data.begin(), image.Data.end());
+    return WriteFile(path, out);
+}
+
+static void PutKeyValue(std::vector<unsigned char>& out, const char* key, const char* value)
+{
+    size_t keyLength = strlen(key) + 1, valueLength = strlen(value) + 1;
+    PutU32(out, (uint32_t)(keyLength + valueLength));
+    out.insert(out.end(), key, key + keyLength);
+    out.insert(out.end(), value, value + valueLength);
+    while (out.size() % 4)
+        out.push_back(0);
+}
+
+bool TextureCompressor::WriteKTX2(const std::string& path, const CompressedImage& image)
+{
+    if (!IsBC1OrBC3(path, image.Format))
+        return false;
+    bool bc1 = image.Format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    unsigned int blockSize = CompressedImage::GetBlockSize(image.Format);
+    uint32_t levelCount = (uint32_t)image.Levels.size();
+    
+    //Data format descriptor, one basic block saying what's inside each 4x4 block
+    std::vector<unsigned char> descriptor;
+    uint32_t sampleCount = bc1 ? 1 : 2;
+    PutU32(descriptor, 4 + 24 + 16 * sampleCount);
+    PutU32(descriptor, 0);
+    PutU32(descriptor, 2 | ((24 + 16 * sampleCount) << 16));
+    //Color model BC1A (128) or BC3 (130), BT.709 primaries, linear transfer like GL_RGBA8 gets
+    PutU32(descriptor, (bc1 ? 128 : 130) | (1 << 8) | (1 << 16));
+    //4x4x1 texels (stored minus one), bytes per block
+    PutU32(descriptor, 3 | (3 << 8));
+    PutU32(descriptor, blockSize);
+    PutU32(descriptor, 0);
+    if (!bc1)
+    {
+        //Alpha is the first 64 bits
+        PutU32(descriptor, 0 | (63 << 16) | (15u << 24));
+        PutU32(descriptor, 0);
+        PutU32(descriptor, 0);
+        PutU32(descriptor, 0xFFFFFFFF);
+    }
+    PutU32(descriptor, (bc1 ? 0 : 64) | (63 << 16));
+    PutU32(descriptor, 0);
+    PutU32(descriptor, 0);
+    PutU32(descriptor, 0xFFFFFFFF);
+    
+    //Keys have to be sorted
+    std::vector<unsigned char> keyValues;
+    PutKeyValue(keyValues, "KTXorientation", image.BottomUp ? "ru" : "rd");
+    PutKeyValue(keyValues, "KTXwriter", "OpenGL_Sample TextureCompressor");
+    
+    size_t descriptorOffset = 80 + levelCount * 24;
+    size_t keyValueOffset = descriptorOffset + descriptor.size();
+    //Level data starts on a block boundary
+    size_t dataOffset = (keyValueOffset + keyValues.size() + blockSize - 1) / blockSize * blockSize;
+    
+    static const unsigned char s_Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+    std::vector<unsigned char> out(s_Identifier, s_Identifier + 12);
+    //VK_FORMAT_BC1_RGB_UNORM_BLOCK or VK_FORMAT_BC3_UNORM_BLOCK
+    PutU32(out, bc1 ? 131 : 137);
+    //Type size, 1 for block compressed
+    PutU32(out, 1);
+    PutU32(out, (uint32_t)image.Width);
+    PutU32(out, (uint32_t)image.Height);
+    //Depth, layers, faces, levels, supercompression
+    PutU32(out, 0);
+    PutU32(out, 0);
+    PutU32(out, 1);
+    PutU32(out, levelCount);
+    PutU32(out, 0);
+    PutU32(out, (uint32_t)descriptorOffset);
+    PutU32(out, (uint32_t)descriptor.size());
+    PutU32(out, (uint32_t)keyValueOffset);
+    PutU32(out, (uint32_t)keyValues.size());
+    PutU64(out, 0);
+    PutU64(out, 0);
+    
+    //The spec wants the smallest level first in the file, the index is still biggest first
+    std::vector<uint64_t> offsets(levelCount);
+    uint64_t offset = dataOffset;
+    for (uint32_t level = levelCount; level-- > 0;)
+    {
+        offsets[level] = offset;
+        offset += image.Levels[level].Size;
+    }
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        PutU64(out, offsets[level]);
+        PutU64(out, image.Levels[level].Size);
+        PutU64(out, image.Levels[level].Size);
+    }
+    
+    out.insert(out.end(), descriptor.begin(), descriptor.end());
+    out.insert(out.end(), keyValues.begin(), keyValues.end());
+    out.resize(dataOffset, 0);
+    for (uint32_t level = levelCount; level-- > 0;)
+    {
+        const unsigned char* data = &image.Data[image.Levels[level].Offset];
+        out.insert(out.end(), data, data + image.Levels[level].Size);
+    }
+    return WriteFile(path, out);
+}
+
+bool TextureCompressor::CompressFile(const std::string& input, const std::string& output, bool mipmaps)
+{
+    //Files are written top row first, so no flip (this thread's flag wins over the global one Texture sets)
+    stbi_set_flip_vertically_on_load_thread(0);
+    int width = 0, height = 0, bpp = 0;
+    unsigned char* pixels = stbi_load(input.c_str(), &width, &height, &bpp, 4);
+    //stb can't go back to using the global flag, so put back what every other load on this thread expects
+    stbi_set_flip_vertically_on_load_thread(1);
+    if (!pixels)
+    {
+        std::cout << "Failed to load " << input << std::endl;
+        return false;
+    }
+    CompressedImage image = Compress(pixels, width, height, mipmaps);
+    stbi_image_free(pixels);
+    
+    std::string extension = std::filesystem::path(output).extension().string();
+    bool written = extension == ".dds" ? WriteDDS(output, image) : WriteKTX2(output, image);
+    if (written)
+    {
+        unsigned long long rgbaSize = 0;
+        for (const CompressedImage::Level& level : image.Levels)
+            rgbaSize += (unsigned long long)level.Width * level.Height * 4;
+        std::cout << input << " -> " << output << " (" << CompressedImage::GetFormatName(image.Format) << ", " << image.Levels.size()
+            << " levels, " << image.Data.size() / 1024 << " KB instead of " << rgbaSize / 1024 << " KB)" << std::endl;
+    }
+    return written;
+}
+
+int TextureCompressor::CompressDirectory(const std::string& directory, const std::string& extension)
+{
+    int failed = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+    {
+        std::filesystem::path path = entry.path();
+        std::string fileExtension = path.extension().string();
+        std::transform(fileExtension.begin(), fileExtension.end(), fileExtension.begin(), ::tolower);
+        if (fileExtension != ".png")
+            continue;
+        if (!CompressFile(path.string(), std::filesystem::path(path).replace_extension(extension).string()))
+            failed++;
+    }
+    if (error)
+    {
+        std::cout << "Couldn't read " << directory << ": " << error.message() << std::endl;
+        failed++;
+    }
+    return failed;
+}
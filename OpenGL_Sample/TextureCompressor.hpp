@@ -0,0 +1,39 @@
+//
+//  TextureCompressor.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TextureCompressor_hpp
+#define TextureCompressor_hpp
+
+#include <string>
+
+#include "CompressedImage.hpp"
+
+//Offline BC1/BC3 encoder, run with --compress-textures to turn the PNGs under res/textures into .ktx2 (or .dds) files
+//  - Opaque images become BC1 (8:1 against RGBA8), anything with alpha becomes BC3 (4:1)
+//  - Endpoints come from the principal axis of each 4x4 block, refined once with least squares
+//  - The whole mip chain is built first with the same filter as MipmapMode::CPUBox, then every level is encoded
+//No GL needed. BC7 and ETC2 encoders are far bigger, use toktx or texconv for those and load the result as usual
+class TextureCompressor
+{
+public:
+    //RGBA image, top row first like the files want it. Returns BC1 or BC3 depending on whether any pixel isn't opaque
+    static CompressedImage Compress(const unsigned char* pixels, int width, int height, bool mipmaps = true);
+    //Reads any image stb_image can and writes output, .dds or .ktx2 by its extension
+    static bool CompressFile(const std::string& input, const std::string& output, bool mipmaps = true);
+    //Every .png in directory, written next to it with extension (".ktx2" or ".dds"). Returns how many failed
+    static int CompressDirectory(const std::string& directory, const std::string& extension);
+    
+    static bool WriteDDS(const std::string& path, const CompressedImage& image);
+    static bool WriteKTX2(const std::string& path, const CompressedImage& image);
+    
+    //16 RGBA pixels (4 rows of 4) to one 8 byte block
+    static void EncodeBC1Block(const unsigned char* pixels, unsigned char* block);
+    //16 RGBA pixels to one 16 byte block, 8 bytes of alpha then a BC1 color block
+    static void EncodeBC3Block(const unsigned char* pixels, unsigned char* block);
+};
+
+#endif /* TextureCompressor_hpp */
@@ -0,0 +1,215 @@
+//
+//  TextureLoader.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TextureLoader.hpp"
+#include "CPUProfiler.hpp"
+#include "RenderStats.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+#include "stb_image/stb_image.h"
+
+//Mid grey so a missing texture is obvious without being as loud as magenta
+static const unsigned char s_PlaceholderPixel[4] = { 128, 128, 128, 255 };
+
+TextureLoader::TextureLoader(unsigned int threadCount, unsigned int uploadBudget)
+    : m_Quit(false), m_UploadBudget(uploadBudget), m_PixelBuffer(0), m_Pending(0)
+{
+    for (unsigned int i = 0; i < threadCount; i++)
+        m_Workers.emplace_back(&TextureLoader::WorkerLoop, this);
+}
+
+TextureLoader::~TextureLoader()
+{
+    Shutdown();
+}
+
+TextureLoader& TextureLoader::Get()
+{
+    static TextureLoader loader;
+    return loader;
+}
+
+std::shared_ptr<Texture> TextureLoader::Load(const std::string& path, const TextureOptions& options)
+{
+    std::shared_ptr<Texture> texture = std::make_shared<Texture>(1, 1, s_PlaceholderPixel, options);
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        Job job;
+        job.Path = path;
+        job.Target = texture;
+        m_Queue.push_back(job);
+    }
+    m_Pending++;
+    m_Condition.notify_one();
+    return texture;
+}
+
+void TextureLoader::WorkerLoop()
+{
+    //Global flip flag isn't safe to touch from several threads, stb has a per thread one for this
+    stbi_set_flip_vertically_on_load_thread(1);
+    CPU_PROFILE_THREAD("TextureLoader worker");
+    
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Condition.wait(lock, [this]() { return m_Quit || !m_Queue.empty(); });
+            if (m_Quit)
+                return;
+            job = m_Queue.front();
+            m_Queue.pop_front();
+        }
+        
+        //Nobody wants it anymore, don't bother decoding
+        if (!job.Target.expired() && CompressedImage::IsCompressedPath(job.Path))
+        {
+            std::shared_ptr<CompressedImage> image = std::make_shared<CompressedImage>();
+            if (CompressedImage::Load(job.Path, *image))
+                job.Compressed = image;
+            else
+            {
+                //Same fallback as the Texture constructor
+                job.Path = std::filesystem::path(job.Path).replace_extension(".png").string();
+                std::cout << "Loading " << job.Path << " instead" << std::endl;
+            }
+        }
+        if (!job.Target.expired() && !job.Compressed)
+        {
+            CPU_PROFILE_SCOPE("Texture decode");
+            int bpp = 0;
+            job.Pixels = stbi_load(job.Path.c_str(), &job.Width, &job.Height, &bpp, 4);
+        }
+        
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Decoded.push_back(job);
+    }
+}
+
+void TextureLoader::Update()
+{
+    CPU_PROFILE_FUNCTION();
+    unsigned int uploaded = 0;
+    while (true)
+    {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Decoded.empty())
+                break;
+            unsigned int size = m_Decoded.front().GetSize();
+            //Over budget, leave the rest for next frame (first one always goes so huge images still make progress)
+            if (uploaded > 0 && uploaded + size > m_UploadBudget)
+                break;
+            job = m_Decoded.front();
+            m_Decoded.pop_front();
+        }
+        m_Pending--;
+        
+        std::shared_ptr<Texture> texture = job.Target.lock();
+        if (job.Compressed)
+        {
+            if (!texture)
+                continue;
+            if (!texture->SetCompressedImage(*job.Compressed))
+            {
+                //Driver can't sample the format, send the .png next to it back through the workers
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                job.Path = std::filesystem::path(job.Path).replace_extension(".png").string();
+                job.Compressed = nullptr;
+                std::cout << "Loading " << job.Path << " instead" << std::endl;
+                m_Queue.push_back(job);
+                m_Pending++;
+                m_Condition.notify_one();
+                continue;
+            }
+            //Residency can read it from disk again instead of keeping a copy when it's evicted
+            texture->SetSourcePath(job.Path);
+            uploaded += job.GetSize();
+            continue;
+        }
+        if (!job.Pixels)
+        {
+            if (texture)
+                std::cout << "Warning: failed to load texture " << job.Path << std::endl;
+            continue;
+        }
+        if (!texture)
+        {
+            stbi_image_free(job.Pixels);
+            continue;
+        }
+        
+        unsigned int size = (unsigned int)(job.Width * job.Height * 4);
+        //CPU mipmaps are built from the pixels in memory, a pixel buffer would hide them from Texture
+        if (texture->GetOptions().Mipmaps == MipmapMode::CPUBox)
+        {
+            texture->SetImage(job.Width, job.Height, job.Pixels);
+            texture->SetSourcePath(job.Path);
+            stbi_image_free(job.Pixels);
+            uploaded += size;
+            continue;
+        }
+        if (!m_PixelBuffer)
+        {
+            GLCall(glGenBuffers(1, &m_PixelBuffer));
+        }
+        //Copy into a pixel buffer object so glTexImage2D can return straight away and let the driver DMA it later
+        //Re-specifying the storage orphans last frame's copy instead of waiting for the GPU to finish reading it
+        GLCall(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_PixelBuffer));
+        GLCall(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW));
+        GLCall(void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+        if (mapped)
+        {
+            memcpy(mapped, job.Pixels, size);
+            GLCall(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+            RenderStats::OnBufferUpload(size);
+            //With an unpack buffer bound the pointer is an offset into it
+            texture->SetImage(job.Width, job.Height, nullptr);
+        }
+        else
+        {
+            //Couldn't map, fall back to a plain upload
+            GLCall(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+            texture->SetImage(job.Width, job.Height, job.Pixels);
+        }
+        GLCall(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+        texture->SetSourcePath(job.Path);
+        
+        stbi_image_free(job.Pixels);
+        uploaded += size;
+    }
+}
+
+void TextureLoader::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Quit = true;
+    }
+    m_Condition.notify_all();
+    for (std::thread& worker : m_Workers)
+        worker.join();
+    m_Workers.clear();
+    
+    for (Job& job : m_Decoded)
+        if (job.Pixels)
+            stbi_image_free(job.Pixels);
+    m_Decoded.clear();
+    m_Queue.clear();
+    m_Pending = 0;
+    
+    if (m_PixelBuffer)
+    {
+        GLCall(glDeleteBuffers(1, &m_PixelBuffer));
+        m_PixelBuffer = 0;
+    }
+}
@@ -0,0 +1,77 @@
+//
+//  TextureLoader.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TextureLoader_hpp
+#define TextureLoader_hpp
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Texture.hpp"
+
+//Loads textures without blocking the render thread
+//  - Load hands back a 1x1 placeholder texture straight away and queues the file
+//  - Worker threads decode with stb_image, or just read .dds/.ktx2 files since those go up compressed
+//  - Update (GL thread, once per frame) uploads finished images through a pixel buffer object,
+//    stopping once the frame's byte budget is used up so a pile of big textures can't cause a hitch
+//The returned texture keeps its GL name the whole time, so it can be bound and drawn before it's ready
+class TextureLoader
+{
+private:
+    struct Job
+    {
+        std::string Path;
+        //Texture might be destroyed before its image arrives, in which case the upload is skipped
+        std::weak_ptr<Texture> Target;
+        unsigned char* Pixels = nullptr;
+        int Width = 0, Height = 0;
+        //Set instead of Pixels for .dds and .ktx2 files
+        std::shared_ptr<CompressedImage> Compressed;
+        
+        //Bytes Update will upload for this job
+        inline unsigned int GetSize() const { return Compressed ? (unsigned int)Compressed->Data.size() : (unsigned int)(Width * Height * 4); }
+    };
+    
+    std::vector<std::thread> m_Workers;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    //Waiting to be decoded
+    std::deque<Job> m_Queue;
+    //Decoded, waiting for Update to upload them
+    std::deque<Job> m_Decoded;
+    bool m_Quit;
+    
+    //Bytes Update is allowed to upload per call, always uploads at least one image
+    unsigned int m_UploadBudget;
+    unsigned int m_PixelBuffer;
+    unsigned int m_Pending;
+public:
+    TextureLoader(unsigned int threadCount = 2, unsigned int uploadBudget = 4 * 1024 * 1024);
+    ~TextureLoader();
+    
+    //Shared instance, main.cpp calls Update every frame and Shutdown before the context goes away
+    static TextureLoader& Get();
+    
+    //Options apply to the placeholder too, so sampling is already right when the real image arrives
+    std::shared_ptr<Texture> Load(const std::string& path, const TextureOptions& options = TextureOptions());
+    void Update();
+    //Stops the workers and frees GL objects, needs the context to still be current
+    void Shutdown();
+    
+    inline void SetUploadBudget(unsigned int bytes) { m_UploadBudget = bytes; }
+    //Textures still showing their placeholder
+    inline unsigned int GetPendingCount() const { return m_Pending; }
+private:
+    void WorkerLoop();
+};
+
+#endif /* TextureLoader_hpp */
@@ -0,0 +1,104 @@
+//
+//  TextureResidency.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TextureResidency.hpp"
+#include "CPUProfiler.hpp"
+#include "Texture.hpp"
+
+#include <algorithm>
+
+#include "imgui/imgui.h"
+
+std::vector<Texture*> TextureResidency::s_Textures;
+unsigned long long TextureResidency::s_Budget = 0;
+unsigned int TextureResidency::s_MinIdleFrames = 60;
+//Starts at 1 so a texture that was never bound (last used 0) is always the oldest
+unsigned long long TextureResidency::s_Frame = 1;
+TextureResidencyStats TextureResidency::s_Stats;
+
+void TextureResidency::SetBudget(unsigned long long bytes)
+{
+    s_Budget = bytes;
+}
+
+void TextureResidency::BeginFrame()
+{
+    s_Frame++;
+    if (s_Budget)
+        Evict();
+}
+
+void TextureResidency::Register(Texture* texture)
+{
+    s_Textures.push_back(texture);
+}
+
+void TextureResidency::Unregister(Texture* texture)
+{
+    auto it = std::find(s_Textures.begin(), s_Textures.end(), texture);
+    if (it == s_Textures.end())
+        return;
+    //Order doesn't matter, Evict sorts anyway
+    *it = s_Textures.back();
+    s_Textures.pop_back();
+}
+
+void TextureResidency::OnRestored(double ms)
+{
+    s_Stats.Restores++;
+    s_Stats.RestoreMs += ms;
+}
+
+unsigned long long TextureResidency::GetResidentBytes()
+{
+    unsigned long long bytes = 0;
+    for (const Texture* texture : s_Textures)
+        bytes += texture->GetMemorySize();
+    return bytes;
+}
+
+void TextureResidency::Evict()
+{
+    unsigned long long resident = GetResidentBytes();
+    if (resident <= s_Budget)
+        return;
+    CPU_PROFILE_FUNCTION();
+    
+    std::vector<Texture*> candidates;
+    for (Texture* texture : s_Textures)
+        if (texture->IsResident() && texture->GetMemorySize() && s_Frame - texture->GetLastUsedFrame() >= s_MinIdleFrames)
+            candidates.push_back(texture);
+    std::sort(candidates.begin(), candidates.end(), [](const Texture* a, const Texture* b) {
+        return a->GetLastUsedFrame() < b->GetLastUsedFrame();
+    });
+    
+    for (Texture* texture : candidates)
+    {
+        if (resident <= s_Budget)
+            break;
+        resident -= texture->GetMemorySize();
+        texture->Evict();
+        s_Stats.Evictions++;
+    }
+}
+
+void TextureResidency::OnImGuiRender()
+{
+    if (!ImGui::CollapsingHeader("Texture Residency"))
+        return;
+    
+    //In MB for the slider, 0 is no limit
+    int budgetMB = (int)(s_Budget / (1024 * 1024));
+    if (ImGui::SliderInt("Budget (MB, 0 = none)", &budgetMB, 0, 512))
+        SetBudget((unsigned long long)budgetMB * 1024 * 1024);
+    
+    unsigned int resident = 0;
+    for (const Texture* texture : s_Textures)
+        resident += texture->IsResident() ? 1 : 0;
+    ImGui::Text("Resident: %u of %u textures, %.1f MB", resident, (unsigned int)s_Textures.size(), GetResidentBytes() / (1024.0f * 1024.0f));
+    ImGui::Text("Evictions: %u, restores: %u (%.1f ms)", s_Stats.Evictions, s_Stats.Restores, s_Stats.RestoreMs);
+}
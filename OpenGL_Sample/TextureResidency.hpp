@@ -0,0 +1,65 @@
+//
+//  TextureResidency.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TextureResidency_hpp
+#define TextureResidency_hpp
+
+#include <vector>
+
+class Texture;
+
+struct TextureResidencyStats
+{
+    unsigned int Evictions = 0;
+    //Evicted textures that were bound again and had to come back
+    unsigned int Restores = 0;
+    //Time spent bringing them back (decode or copy plus upload), the cost of a budget that's too small
+    double RestoreMs = 0.0;
+};
+
+//Keeps texture memory under a budget by evicting the least recently bound textures
+//  - Texture::Bind stamps the current frame on the texture, BeginFrame adds up what's resident
+//    and, if that's over budget, evicts textures that haven't been bound for a while, oldest first
+//  - Evicted textures keep their size and options but give their GL storage back. Ones loaded from a file
+//    are read again from disk, anything else is copied back to the CPU first
+//  - Binding an evicted texture uploads it again before it's used, so nothing else has to know
+//The budget is soft: textures bound in the last few frames are never evicted, even if that leaves it over budget
+//No budget (0) by default, in which case nothing is ever evicted
+class TextureResidency
+{
+public:
+    //Bytes of texture memory to stay under, 0 for no limit
+    static void SetBudget(unsigned long long bytes);
+    inline static unsigned long long GetBudget() { return s_Budget; }
+    //How long a texture has to go unbound before it can be evicted
+    inline static void SetMinIdleFrames(unsigned int frames) { s_MinIdleFrames = frames; }
+    
+    //Call once at the start of every frame
+    static void BeginFrame();
+    inline static unsigned long long GetFrame() { return s_Frame; }
+    
+    //Texture does these itself
+    static void Register(Texture* texture);
+    static void Unregister(Texture* texture);
+    static void OnRestored(double ms);
+    
+    static unsigned long long GetResidentBytes();
+    inline static const TextureResidencyStats& GetStats() { return s_Stats; }
+    
+    //Collapsible section for whatever ImGui window is current
+    static void OnImGuiRender();
+private:
+    static void Evict();
+    
+    static std::vector<Texture*> s_Textures;
+    static unsigned long long s_Budget;
+    static unsigned int s_MinIdleFrames;
+    static unsigned long long s_Frame;
+    static TextureResidencyStats s_Stats;
+};
+
+#endif /* TextureResidency_hpp */
@@ -0,0 +1,56 @@
+//
+//  UniformBuffer.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "UniformBuffer.hpp"
+#include "Renderer.h"
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
+
+//Function local so blocks can be registered from other files' static initialisers
+static std::map<std::string, UniformBuffer::BlockInfo>& GetBlocks()
+{
+    static std::map<std::string, UniformBuffer::BlockInfo> blocks;
+    return blocks;
+}
+
+UniformBuffer::UniformBuffer(unsigned int size, unsigned int binding)
+    : m_RendererID(0), m_Size(size), m_Binding(binding)
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+    GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+    //Rewritten every frame
+    GLCall(glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+    BindBase();
+}
+
+UniformBuffer::~UniformBuffer()
+{
+    GLCall(glDeleteBuffers(1, &m_RendererID));
+    GLStateCache::OnBufferDeleted(m_RendererID);
+}
+
+void UniformBuffer::SetData(const void* data, unsigned int size, unsigned int offset)
+{
+    GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+    GLCall(glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data));
+    RenderStats::OnBufferUpload(size);
+}
+
+void UniformBuffer::BindBase() const
+{
+    GLCall(glBindBufferBase(GL_UNIFORM_BUFFER, m_Binding, m_RendererID));
+}
+
+void UniformBuffer::RegisterBlock(const std::string& name, unsigned int binding, unsigned int size)
+{
+    GetBlocks()[name] = { binding, size };
+}
+
+const std::map<std::string, UniformBuffer::BlockInfo>& UniformBuffer::GetRegisteredBlocks()
+{
+    return GetBlocks();
+}
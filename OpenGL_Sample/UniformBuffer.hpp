@@ -0,0 +1,104 @@
+//
+//  UniformBuffer.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef UniformBuffer_hpp
+#define UniformBuffer_hpp
+
+#include <map>
+#include <string>
+
+#include "glm/glm.hpp"
+
+//Works out where each member of a layout(std140) uniform block goes, push members in the order the shader declares them
+//  Std140Layout layout;
+//  unsigned int viewOffset = layout.Push<glm::mat4>();
+//  unsigned int timeOffset = layout.Push<float>();
+//  layout.GetSize() -> bytes the buffer needs
+class Std140Layout
+{
+private:
+    unsigned int m_Size;
+public:
+    Std140Layout()
+    : m_Size(0) {}
+    
+    //Returns the byte offset of the member, count > 1 makes it an array
+    template<typename T>
+    unsigned int Push(unsigned int count = 1);
+    
+    //Blocks are padded out to a multiple of a vec4
+    inline unsigned int GetSize() const { return (m_Size + 15) / 16 * 16; }
+private:
+    //std140 arrays round every element up to a vec4, whatever the element type
+    unsigned int Add(unsigned int alignment, unsigned int size, unsigned int count)
+    {
+        if (count > 1)
+        {
+            alignment = 16;
+            size = (size + 15) / 16 * 16 * count;
+        }
+        unsigned int offset = (m_Size + alignment - 1) / alignment * alignment;
+        m_Size = offset + size;
+        return offset;
+    }
+};
+
+//Specializations
+//Defined at namespace scope since explicit specializations inside the class body are a clang extension
+template<>
+inline unsigned int Std140Layout::Push<float>(unsigned int count) { return Add(4, 4, count); }
+
+template<>
+inline unsigned int Std140Layout::Push<int>(unsigned int count) { return Add(4, 4, count); }
+
+template<>
+inline unsigned int Std140Layout::Push<glm::vec2>(unsigned int count) { return Add(8, 8, count); }
+
+//vec3 is aligned like a vec4 but only takes 12 bytes, a float can slot in right after it
+template<>
+inline unsigned int Std140Layout::Push<glm::vec3>(unsigned int count) { return Add(16, 12, count); }
+
+template<>
+inline unsigned int Std140Layout::Push<glm::vec4>(unsigned int count) { return Add(16, 16, count); }
+
+//Laid out as 4 vec4 columns, same as glm stores it
+template<>
+inline unsigned int Std140Layout::Push<glm::mat4>(unsigned int count) { return Add(16, 64, count); }
+
+//Buffer backing a uniform block, attached to a binding point that every program reading the block is pointed at
+//Lets data shared by lots of programs (camera matrices etc.) be uploaded once per frame instead of once per program per draw
+class UniformBuffer
+{
+private:
+    unsigned int m_RendererID;
+    unsigned int m_Size;
+    unsigned int m_Binding;
+public:
+    //Allocates size bytes and attaches the buffer to binding
+    UniformBuffer(unsigned int size, unsigned int binding);
+    ~UniformBuffer();
+    
+    void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+    //Attaches to the binding point again, e.g. if another buffer was attached to it since
+    void BindBase() const;
+    
+    inline unsigned int GetSize() const { return m_Size; }
+    inline unsigned int GetBinding() const { return m_Binding; }
+    
+    //GL 3.3 shaders can't say layout(binding = N) (that's 4.2), so Shader points every block it finds
+    //with a registered name at that block's binding point right after linking
+    //size is what the block should come out as, a different size in a shader gets a warning since the layouts don't match
+    static void RegisterBlock(const std::string& name, unsigned int binding, unsigned int size);
+    struct BlockInfo
+    {
+        unsigned int Binding;
+        unsigned int Size;
+    };
+    static const std::map<std::string, BlockInfo>& GetRegisteredBlocks();
+};
+
+#endif /* UniformBuffer_hpp */
@@ -0,0 +1,68 @@
+//
+//  UniformId.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "UniformId.hpp"
+
+UniformHashTable::UniformHashTable()
+    : m_Entries(16), m_Mask(15), m_Count(0)
+{
+}
+
+void UniformHashTable::Clear()
+{
+    m_Entries.assign(16, Entry());
+    m_Mask = 15;
+    m_Count = 0;
+}
+
+bool UniformHashTable::Insert(uint32_t hash, int value)
+{
+    //Keep at least half the slots empty so probes stay short
+    if ((m_Count + 1) * 2 > m_Entries.size())
+        Grow();
+    
+    for (uint32_t i = hash & m_Mask; ; i = (i + 1) & m_Mask)
+    {
+        Entry& entry = m_Entries[i];
+        if (entry.Hash == hash)
+            return false;
+        if (entry.Hash == 0)
+        {
+            entry.Hash = hash;
+            entry.Value = value;
+            m_Count++;
+            return true;
+        }
+    }
+}
+
+int UniformHashTable::Find(uint32_t hash, int notFound) const
+{
+    for (uint32_t i = hash & m_Mask; ; i = (i + 1) & m_Mask)
+    {
+        const Entry& entry = m_Entries[i];
+        if (entry.Hash == hash)
+            return entry.Value;
+        //Table is never full so an empty slot always ends the probe
+        if (entry.Hash == 0)
+            return notFound;
+    }
+}
+
+void UniformHashTable::Grow()
+{
+    std::vector<Entry> old;
+    old.swap(m_Entries);
+    m_Entries.assign(old.size() * 2, Entry());
+    m_Mask = (uint32_t)m_Entries.size() - 1;
+    m_Count = 0;
+    for (const Entry& entry : old)
+    {
+        if (entry.Hash != 0)
+            Insert(entry.Hash, entry.Value);
+    }
+}
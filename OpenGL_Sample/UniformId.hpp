@@ -0,0 +1,74 @@
+//
+//  UniformId.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef UniformId_hpp
+#define UniformId_hpp
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//Uniform name hashed with 32 bit FNV-1a, used instead of std::string to look up uniform locations
+//Constructing one from a string literal never allocates, and a constexpr one is hashed by the compiler:
+//  static constexpr UniformId s_MVP("u_MVP");
+//  shader.SetUniformMat4f(s_MVP, mvp);
+//Passing "u_MVP" straight to SetUniform works too, it just hashes the few characters at runtime
+class UniformId
+{
+private:
+    uint32_t m_Hash;
+    //Only kept for warning messages, has to outlive the UniformId
+    const char* m_Name;
+public:
+    constexpr UniformId(const char* name)
+        : m_Hash(Hash(name)), m_Name(name) {}
+    UniformId(const std::string& name)
+        : m_Hash(Hash(name.c_str())), m_Name(name.c_str()) {}
+    
+    constexpr uint32_t GetHash() const { return m_Hash; }
+    constexpr const char* GetName() const { return m_Name; }
+    
+    static constexpr uint32_t Hash(const char* name)
+    {
+        uint32_t hash = 2166136261u;
+        for (; *name; name++)
+            hash = (hash ^ (uint8_t)*name) * 16777619u;
+        //0 marks an empty slot in UniformHashTable
+        return hash ? hash : 1;
+    }
+};
+
+//Name hash -> int, e.g. a uniform's index in ShaderReflection
+//Open addressing with linear probing in one flat array, so a lookup is a couple of compares in memory
+//we've almost certainly touched recently, and nothing is allocated once it's filled
+class UniformHashTable
+{
+private:
+    struct Entry
+    {
+        uint32_t Hash = 0;
+        int Value = -1;
+    };
+    std::vector<Entry> m_Entries;
+    //Capacity - 1, capacity is always a power of two
+    uint32_t m_Mask;
+    unsigned int m_Count;
+public:
+    UniformHashTable();
+    
+    void Clear();
+    //Returns false (and leaves the old value) if the hash was already there
+    bool Insert(uint32_t hash, int value);
+    //Returns notFound if the hash isn't there
+    int Find(uint32_t hash, int notFound = -1) const;
+    
+    inline unsigned int GetCount() const { return m_Count; }
+private:
+    void Grow();
+};
+
+#endif /* UniformId_hpp */
@@ -6,47 +6,74 @@
 //
 
 #include "VertexArray.hpp"
+#include "CPUProfiler.hpp"
 #include "VertexBufferLayout.hpp"
 #include "Renderer.h"
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
 
 VertexArray::VertexArray()
+    : m_AttribCount(0)
 {
     GLCall(glGenVertexArrays(1, &m_RendererID));
+    RenderStats::OnObjectCreated(GLObjectType::VertexArray);
 }
 
 VertexArray::~VertexArray()
 {
     GLCall(glDeleteVertexArrays(1, &m_RendererID));
+    GLStateCache::OnVertexArrayDeleted(m_RendererID);
+    RenderStats::OnObjectDestroyed(GLObjectType::VertexArray);
 }
 
 void VertexArray::AddBuffer(const VertexBuffer &vb, const VertexBufferLayout &layout)
 {
+    CPU_PROFILE_FUNCTION();
     //Bind vertex array
     Bind();
     //Bind vertex buffer
     vb.Bind();
+    AddLayout(layout);
+}
+
+void VertexArray::AddBuffer(const StreamingBuffer& sb, const VertexBufferLayout& layout)
+{
+    CPU_PROFILE_FUNCTION();
+    Bind();
+    sb.Bind();
+    AddLayout(layout);
+}
+
+void VertexArray::AddLayout(const VertexBufferLayout& layout)
+{
     const auto& elements = layout.GetElements();
     unsigned int offset = 0;
+    unsigned int first = layout.HasAttribOffset() ? layout.GetAttribOffset() : m_AttribCount;
     for (unsigned int i = 0; i < elements.size(); i++)
     {
         //Buffer layout
         const auto& element = elements[i];
-        GLCall(glEnableVertexAttribArray(i));
+        unsigned int index = first + i;
+        GLCall(glEnableVertexAttribArray(index));
         //Only need to call once since using one type of attribute
         //Specify the layout of the vertex buffer data
         //This is where "buffer" gets linked to vao
         //Index at first arg is being bound to currently bound GL_ARRAY_BUFFER
-        GLCall(glVertexAttribPointer(i, element.count, element.type, element.normalized, layout.GetStride(), (const void*)offset));
-       offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
+        GLCall(glVertexAttribPointer(index, element.count, element.type, element.normalized, layout.GetStride(), (const void*)(size_t)offset));
+        //Per instance attributes only move forward once every divisor instances instead of every vertex
+        GLCall(glVertexAttribDivisor(index, element.divisor));
+        offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
     }
+    if (first + elements.size() > m_AttribCount)
+        m_AttribCount = first + (unsigned int)elements.size();
 }
 
 void VertexArray::Bind() const
 {
-    GLCall(glBindVertexArray(m_RendererID));
+    GLStateCache::BindVertexArray(m_RendererID);
 }
 
 void VertexArray::Unbind() const
 {
-    GLCall(glBindVertexArray(0));
+    GLStateCache::BindVertexArray(0);
 }
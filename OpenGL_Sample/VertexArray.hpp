@@ -6,6 +6,7 @@
 //
 
 #include "VertexBuffer.hpp"
+#include "StreamingBuffer.hpp"
 
 //Changing to forward declaration
 //After changes to Renderer files, circular dependency was created when including VertexBufferLayout.hpp
@@ -18,14 +19,23 @@ class VertexArray
 {
 private:
     unsigned int m_RendererID;
+    //Next free attribute index, lets several buffers (e.g. per vertex + per instance) share one vertex array
+    unsigned int m_AttribCount;
 public:
     VertexArray();
     ~VertexArray();
     
+    //Can be called once per buffer, each layout picks up at the attribute index after the previous one
+    //unless it was given an explicit attribute offset
     void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+    //Attribute offsets are relative to the start of the whole buffer, draw with a base vertex to pick the written range
+    void AddBuffer(const StreamingBuffer& sb, const VertexBufferLayout& layout);
     
     void Bind() const;
     void Unbind() const;
+private:
+    //Points attributes at whatever is bound to GL_ARRAY_BUFFER
+    void AddLayout(const VertexBufferLayout& layout);
 };
 
 #endif /* VertexArray_hpp */
@@ -7,26 +7,55 @@
 
 #include "VertexBuffer.hpp"
 #include "Renderer.h"
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
 
 
 VertexBuffer::VertexBuffer(const void* data, unsigned int size)
+    : m_Size(size)
 {
     GLCall(glGenBuffers(1, &m_RendererID));
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    Bind();
     GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    RenderStats::OnObjectCreated(GLObjectType::VertexBuffer);
+    RenderStats::OnMemoryAllocated(GLObjectType::VertexBuffer, size);
+    if (data)
+        RenderStats::OnBufferUpload(size);
+}
+
+VertexBuffer::VertexBuffer(unsigned int size)
+    : m_Size(size)
+{
+    GLCall(glGenBuffers(1, &m_RendererID));
+    Bind();
+    //No data yet, just reserve the memory on the GPU
+    //GL_DYNAMIC_DRAW hints to the driver that we'll be rewriting this often
+    GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+    RenderStats::OnObjectCreated(GLObjectType::VertexBuffer);
+    RenderStats::OnMemoryAllocated(GLObjectType::VertexBuffer, size);
 }
 
 VertexBuffer::~VertexBuffer()
 {
     GLCall(glDeleteBuffers(1, &m_RendererID));
+    GLStateCache::OnBufferDeleted(m_RendererID);
+    RenderStats::OnObjectDestroyed(GLObjectType::VertexBuffer);
+    RenderStats::OnMemoryFreed(GLObjectType::VertexBuffer, m_Size);
 }
 
 void VertexBuffer::Bind() const
 {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 }
 
 void VertexBuffer::Unbind() const
 {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void VertexBuffer::SetData(const void* data, unsigned int size, unsigned int offset)
+{
+    Bind();
+    GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+    RenderStats::OnBufferUpload(size);
 }
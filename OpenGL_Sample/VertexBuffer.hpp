@@ -12,12 +12,20 @@ class VertexBuffer
 {
 private:
     unsigned int m_RendererID;
+    unsigned int m_Size;
 public:
     VertexBuffer(const void* data, unsigned int size);
+    //Allocates size bytes of GL_DYNAMIC_DRAW storage to be filled later with SetData
+    VertexBuffer(unsigned int size);
     ~VertexBuffer();
     
+    //Overwrites part of the buffer's storage, offset and size are in bytes
+    void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+    
     void Bind() const;
     void Unbind() const;
+    
+    inline unsigned int GetSize() const { return m_Size; }
 };
 
 
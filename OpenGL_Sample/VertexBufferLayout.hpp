@@ -11,6 +11,8 @@
 #include <GL/glew.h>
 #include <stdexcept>
 
+#include "glm/glm.hpp"
+
 #ifndef VertexBufferLayout_hpp
 #define VertexBufferLayout_hpp
 
@@ -20,6 +22,8 @@ struct VertexBufferElement
     unsigned int type;
     unsigned int count;
     unsigned char normalized;
+    //0 advances the attribute every vertex, N advances it once every N instances
+    unsigned int divisor;
     
     static unsigned int GetSizeOfType(unsigned int type)
     {
@@ -39,12 +43,20 @@ class VertexBufferLayout
 private:
     std::vector<VertexBufferElement> m_Elements;
     unsigned int m_Stride;
+    //First attribute index this layout is bound to
+    //-1 means carry on from wherever the previous buffer added to the vertex array stopped
+    int m_AttribOffset;
 public:
     VertexBufferLayout()
-    : m_Stride(0) {}
+    : m_Stride(0), m_AttribOffset(-1) {}
+    
+    //Pins the first element to a specific attribute index, for example to match a layout(location = N) in a shader
+    explicit VertexBufferLayout(unsigned int attribOffset)
+    : m_Stride(0), m_AttribOffset((int)attribOffset) {}
     
+    //divisor is only needed for per instance data, see glVertexAttribDivisor
     template<typename T>
-    void Push(unsigned int count)
+    void Push(unsigned int count, unsigned int divisor = 0)
     {
         //static_assert(false); Doesn't work
         
@@ -52,33 +64,43 @@ public:
         std::runtime_error("Need to use specialization");
     }
     
-    //Specializations
-    template<>
-    void Push<float>(unsigned int count)
-    {
-        m_Elements.push_back({GL_FLOAT, count, GL_FALSE});
-        m_Stride += count * VertexBufferElement::GetSizeOfType(GL_FLOAT);
-    }
-    
-    template<>
-    void Push<unsigned int>(unsigned int count)
-    {
-        m_Elements.push_back({GL_UNSIGNED_INT, count, GL_FALSE});
-        m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT);
-
-    }
-    
-    //Unsigned char really are bytes
-    template<>
-    void Push<unsigned char>(unsigned int count)
-    {
-        m_Elements.push_back({GL_UNSIGNED_BYTE, count, GL_TRUE});
-        m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE);
-
-    }
-    
     inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
     inline unsigned int GetStride() const { return m_Stride; }
+    inline bool HasAttribOffset() const { return m_AttribOffset >= 0; }
+    inline unsigned int GetAttribOffset() const { return (unsigned int)m_AttribOffset; }
 };
 
+//Specializations
+//Defined at namespace scope since explicit specializations inside the class body are a clang extension
+template<>
+inline void VertexBufferLayout::Push<float>(unsigned int count, unsigned int divisor)
+{
+    m_Elements.push_back({GL_FLOAT, count, GL_FALSE, divisor});
+    m_Stride += count * VertexBufferElement::GetSizeOfType(GL_FLOAT);
+}
+    
+template<>
+inline void VertexBufferLayout::Push<unsigned int>(unsigned int count, unsigned int divisor)
+{
+    m_Elements.push_back({GL_UNSIGNED_INT, count, GL_FALSE, divisor});
+    m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT);
+}
+    
+//Unsigned char really are bytes
+template<>
+inline void VertexBufferLayout::Push<unsigned char>(unsigned int count, unsigned int divisor)
+{
+    m_Elements.push_back({GL_UNSIGNED_BYTE, count, GL_TRUE, divisor});
+    m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE);
+}
+    
+//A vertex attribute can be at most a vec4, so a mat4 takes up 4 consecutive attribute indices, one per column
+//Count is the number of matrices
+template<>
+inline void VertexBufferLayout::Push<glm::mat4>(unsigned int count, unsigned int divisor)
+{
+    for (unsigned int i = 0; i < count * 4; i++)
+        Push<float>(4, divisor);
+}
+
 #endif /* VertexBufferLayout_hpp */
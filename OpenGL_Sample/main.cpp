@@ -10,6 +10,9 @@
 #include "GL/glew.h"
 #include "glfw3.h"
 
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -22,6 +25,20 @@
 #include "VertexArray.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "GLStateCache.hpp"
+#include "ShaderCache.hpp"
+#include "ShaderBuildQueue.hpp"
+#include "ShaderWatcher.hpp"
+#include "TextureLoader.hpp"
+#include "TextureCache.hpp"
+#include "TextureResidency.hpp"
+#include "GPUProfiler.hpp"
+#include "CPUProfiler.hpp"
+#include "RenderStats.hpp"
+#include "HeadlessContext.hpp"
+#include "HeadlessRunner.hpp"
+#include "Benchmark.hpp"
+#include "TextureCompressor.hpp"
 
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
@@ -32,9 +49,166 @@
 
 #include "tests/TestClearColor.hpp"
 #include "tests/TestTexture2D.hpp"
+#include "tests/TestBatchRendering.hpp"
+#include "tests/TestInstancing.hpp"
+#include "tests/TestTextureAtlas.hpp"
+#include "tests/TestShaderBuild.hpp"
+#include "tests/TestShaderVariants.hpp"
+#include "tests/TestMipmaps.hpp"
+#include "tests/TestCompressedTexture.hpp"
+#include "tests/TestTextureResidency.hpp"
+#include "tests/TestTextureArray.hpp"
 
-int main(void)
+//Shared by the windowed menu and headless mode
+static void RegisterTests(test::TestMenu& menu)
 {
+    menu.RegisterTest<test::TestClearColor>("Clear Color");
+    menu.RegisterTest<test::TestTexture2D>("2D Texture Test");
+    menu.RegisterTest<test::TestBatchRendering>("Batch Rendering");
+    menu.RegisterTest<test::TestInstancing>("Instanced Quads");
+    menu.RegisterTest<test::TestTextureAtlas>("Texture Atlas");
+    menu.RegisterTest<test::TestShaderBuild>("Shader Build Queue");
+    menu.RegisterTest<test::TestShaderVariants>("Shader Variants");
+    //One entry per mode so a --benchmark run compares them side by side
+    menu.RegisterTest<test::TestMipmaps>("Mipmaps (off)", MipmapMode::None);
+    menu.RegisterTest<test::TestMipmaps>("Mipmaps (GPU)", MipmapMode::GPU);
+    menu.RegisterTest<test::TestMipmaps>("Mipmaps (CPU box)", MipmapMode::CPUBox);
+    menu.RegisterTest<test::TestCompressedTexture>("Compressed Textures");
+    menu.RegisterTest<test::TestTextureResidency>("Texture Residency");
+    menu.RegisterTest<test::TestTextureArray>("Texture Array");
+}
+
+//No window, no vsync, no ImGui. Runs one test (or all of them) for a fixed number of frames and prints frame times
+//  OpenGL_Sample --headless [--frames N] [--warmup N] [--test "Batch Rendering"] [--benchmark results.json] [--trace trace.json]
+static int RunHeadless(const std::string& testName, unsigned int frameCount, unsigned int warmupFrames, const std::string& jsonPath)
+{
+    HeadlessContext context;
+    if (!context.IsValid())
+        return -1;
+    
+    //Every GL call after this goes through GLEW's function pointers, carrying on would just crash
+    GLenum glewError = glewInit();
+    if (glewError != GLEW_OK)
+    {
+        std::cout << "Error initializing GLEW: " << glewGetErrorString(glewError) << std::endl;
+        return -1;
+    }
+    std::cout << glGetString(GL_VERSION) << " (" << glGetString(GL_RENDERER) << ")" << std::endl;
+    
+    GLInitErrorPolicy();
+    
+    GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+    GLCall(glEnable(GL_BLEND));
+    
+    int result = 0;
+    {
+        test::Test* currentTest = nullptr;
+        test::TestMenu menu(currentTest);
+        RegisterTests(menu);
+        
+        HeadlessRunner runner;
+        Benchmark benchmark(runner, warmupFrames, frameCount);
+        if (!benchmark.Run(menu, testName))
+        {
+            std::cout << "No test named \"" << testName << "\"" << std::endl;
+            result = -1;
+        }
+        else if (!jsonPath.empty() && !benchmark.WriteJson(jsonPath))
+            result = -1;
+    }
+    
+    TextureCache::Get().Clear();
+    TextureLoader::Get().Shutdown();
+    ShaderBuildQueue::Get().Shutdown();
+    GPUProfiler::Shutdown();
+    return result;
+}
+
+//strtoul rather than std::stoul, a typo on the command line should get a message instead of an uncaught exception
+static bool ParseUnsigned(const std::string& option, const char* text, unsigned int& value)
+{
+    char* end = nullptr;
+    errno = 0;
+    unsigned long parsed = strtoul(text, &end, 10);
+    //strtoul happily takes "-1" and wraps it around
+    if (end == text || *end != '\0' || text[0] == '-' || errno == ERANGE || parsed > UINT_MAX)
+    {
+        std::cout << option << " needs a whole number, not \"" << text << "\"" << std::endl;
+        return false;
+    }
+    value = (unsigned int)parsed;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    bool headless = false;
+    unsigned int frameCount = 300;
+    unsigned int warmupFrames = 60;
+    std::string testName;
+    std::string jsonPath;
+    //Where the CPU trace gets saved on exit (and by the button in the Test window)
+    std::string tracePath;
+    //".ktx2" or ".dds" to compress res/textures and quit, empty to run normally
+    std::string compressExtension;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--headless")
+            headless = true;
+        else if (arg == "--frames" && i + 1 < argc)
+        {
+            if (!ParseUnsigned(arg, argv[++i], frameCount))
+                return -1;
+        }
+        else if (arg == "--warmup" && i + 1 < argc)
+        {
+            if (!ParseUnsigned(arg, argv[++i], warmupFrames))
+                return -1;
+        }
+        else if (arg == "--test" && i + 1 < argc)
+            testName = argv[++i];
+        else if (arg == "--trace" && i + 1 < argc)
+            tracePath = argv[++i];
+        //Benchmarking never needs a window, so this implies --headless
+        else if (arg == "--benchmark" && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+            headless = true;
+        }
+        //Optional container after it, ktx2 unless it says dds
+        else if (arg == "--compress-textures")
+        {
+            compressExtension = ".ktx2";
+            if (i + 1 < argc && std::string(argv[i + 1]) == "dds")
+            {
+                compressExtension = ".dds";
+                i++;
+            }
+            else if (i + 1 < argc && std::string(argv[i + 1]) == "ktx2")
+                i++;
+        }
+        //In MB, textures past it that haven't been drawn in a while get evicted
+        else if (arg == "--texture-budget" && i + 1 < argc)
+        {
+            unsigned int budgetMB = 0;
+            if (!ParseUnsigned(arg, argv[++i], budgetMB))
+                return -1;
+            TextureResidency::SetBudget((unsigned long long)budgetMB * 1024 * 1024);
+        }
+    }
+    //Offline, no context needed
+    if (!compressExtension.empty())
+        return TextureCompressor::CompressDirectory("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures", compressExtension) ? -1 : 0;
+    CPU_PROFILE_THREAD("Main");
+    if (headless)
+    {
+        int result = RunHeadless(testName, frameCount, warmupFrames, jsonPath);
+        if (!tracePath.empty())
+            CPUProfiler::WriteChromeTrace(tracePath);
+        return result;
+    }
+    
     GLFWwindow* window;
 
     /* Initialize the library */
@@ -46,6 +220,10 @@ int main(void)
     glfwWindowHint( GLFW_CONTEXT_VERSION_MINOR, 3 );
     glfwWindowHint( GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE );
     glfwWindowHint( GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE );
+#if GL_ERROR_POLICY == GL_ERROR_POLICY_DEBUG_OUTPUT
+    //Some drivers only report debug messages for debug contexts
+    glfwWindowHint( GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE );
+#endif
 
     /* Create a windowed mode window and its OpenGL context */
     window = glfwCreateWindow(960, 540, "Hello There", NULL, NULL);
@@ -67,6 +245,8 @@ int main(void)
     //Need to call after context created
     std::cout << glGetString(GL_VERSION) << std::endl;
     
+    GLInitErrorPolicy();
+    
     //How OpenGL is going to blend alpha pixels
     GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
     GLCall(glEnable(GL_BLEND));
@@ -84,12 +264,29 @@ int main(void)
     //Could add CLI arg here to boot up with specific test here
     currentTest = menu;
     
-    menu->RegisterTest<test::TestClearColor>("Clear Color");
-    menu->RegisterTest<test::TestTexture2D>("2D Texture Test");
+    RegisterTests(*menu);
+
+    //Saving a shader file while the app is running rebuilds it in place
+    ShaderWatcher::Get().Start();
 
+    double lastTime = glfwGetTime();
+    
     /* Loop until the user closes the window */
     while (!glfwWindowShouldClose(window))
     {
+        //Real time since the last frame so tests can animate at the same speed whatever the frame rate
+        CPU_PROFILE_SCOPE("Frame");
+        double time = glfwGetTime();
+        float deltaTime = (float)(time - lastTime);
+        lastTime = time;
+        
+        //ImGui and anything else outside our wrappers may have touched the bindings since last frame
+        GLStateCache::BeginFrame();
+        GLStateCache::Invalidate();
+        GPUProfiler::BeginFrame();
+        RenderStats::BeginFrame();
+        TextureResidency::BeginFrame();
+        
         //Reset window clear color to black when exiting color test
         GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
         //Render here
@@ -102,25 +299,68 @@ int main(void)
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
         
+        //Finish off any textures the worker threads have decoded since last frame
+        TextureLoader::Get().Update();
+        //Hand over shaders that finished compiling in the background
+        ShaderBuildQueue::Get().Update();
+        //Swap in any shaders that were edited and have finished building
+        ShaderWatcher::Get().Update();
+        
         if(currentTest)
         {
-            currentTest->OnUpdate(0.0f);
-            currentTest->OnRender();
+            {
+                CPU_PROFILE_SCOPE("Test::OnUpdate");
+                currentTest->OnUpdate(deltaTime);
+            }
+            {
+                CPU_PROFILE_SCOPE("Test::OnRender");
+                GPU_PROFILE_SCOPE("Test::OnRender");
+                currentTest->OnRender();
+            }
             ImGui::Begin("Test");
             if(currentTest != menu && ImGui::Button("<-"))
             {
                 delete currentTest;
                 currentTest = menu;
             }
-            currentTest->OnImGuiRender();
+            {
+                CPU_PROFILE_SCOPE("Test::OnImGuiRender");
+                currentTest->OnImGuiRender();
+            }
+            RenderStats::OnImGuiRender();
+            TextureResidency::OnImGuiRender();
+            const GLStateStats& stateStats = GLStateCache::GetLastFrameStats();
+            ImGui::Text("State changes: %u issued, %u skipped", stateStats.Issued, stateStats.Skipped);
+            const ShaderCacheStats& cacheStats = ShaderCache::GetStats();
+            ImGui::Text("Shader cache: %.0f%% hits (%u/%u), %.1f ms compiling, %.1f ms saved", cacheStats.GetHitRate() * 100.0f,
+                cacheStats.Hits, cacheStats.Hits + cacheStats.Misses, cacheStats.CompileMs, cacheStats.SavedMs);
+            const TextureCacheStats& textureStats = TextureCache::Get().GetStats();
+            ImGui::Text("Texture cache: %.0f%% hits (%u/%u), %u live, %.1f MB retained, %.1f MB not reloaded", textureStats.GetHitRate() * 100.0f,
+                textureStats.Hits, textureStats.Hits + textureStats.Misses, TextureCache::Get().GetLiveCount(),
+                TextureCache::Get().GetRetainedBytes() / (1024.0f * 1024.0f), textureStats.SavedBytes / (1024.0f * 1024.0f));
+#if CPU_PROFILER_ENABLED
+            if (ImGui::Button("Save CPU trace"))
+                CPUProfiler::WriteChromeTrace(tracePath.empty() ? "cpu_trace.json" : tracePath);
+#endif
             ImGui::End();
         }
+        GPUProfiler::OnImGuiRender();
         
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            CPU_PROFILE_SCOPE("ImGui");
+            GPU_PROFILE_SCOPE("ImGui");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
+        
+        GLCheckFrameErrors();
         
         /* Swap front and back buffers */
-        GLCall(glfwSwapBuffers(window));
+        {
+            //Includes waiting on vsync
+            CPU_PROFILE_SCOPE("SwapBuffers");
+            GLCall(glfwSwapBuffers(window));
+        }
 
         /* Poll for and process events */
         GLCall(glfwPollEvents());
@@ -132,6 +372,16 @@ int main(void)
     if(currentTest != menu)
         delete menu;
     
+    //Worker threads and the upload buffer need to go before the context does
+    TextureCache::Get().Clear();
+    TextureLoader::Get().Shutdown();
+    ShaderBuildQueue::Get().Shutdown();
+    ShaderWatcher::Get().Shutdown();
+    GPUProfiler::Shutdown();
+    
+    if (!tracePath.empty())
+        CPUProfiler::WriteChromeTrace(tracePath);
+    
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
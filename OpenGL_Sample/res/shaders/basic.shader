@@ -6,12 +6,23 @@ layout(location = 1) in vec2 texCoord;
 
 out vec2 v_TexCoord;
 
-uniform mat4 u_MVP;
+//Layer per vertex from BatchVertex, only the TextureArray variant reads it
+#ifdef TEXTURE_ARRAY
+layout(location = 2) in float layer;
+flat out float v_Layer;
+#endif
+
+#include "camera.glsl"
+
+uniform mat4 u_Model;
 
 void main()
 {
-   gl_Position = u_MVP * position;
+   gl_Position = u_ViewProjection * u_Model * position;
     v_TexCoord = texCoord;
+#ifdef TEXTURE_ARRAY
+    v_Layer = layer;
+#endif
 }
 
 #shader fragment
@@ -20,12 +31,42 @@ void main()
 layout(location = 0) out vec4 color;
 
 in vec2 v_TexCoord;
+#ifdef TEXTURE_ARRAY
+flat in float v_Layer;
+#endif
 
+//Features are #defined by ShaderVariants right after #version, see ShaderFeature
+//  COLORED     flat u_Color instead of sampling u_Texture
+//  TINT        multiply by u_Color
+//  ALPHA_TEST  discard anything below u_AlphaCutoff instead of relying on blending
+//Not one of ShaderVariants' defaults, passed to Shader by whoever draws with a TextureArray
+//  TEXTURE_ARRAY  u_Texture is a sampler2DArray, sampled at the layer from the vertex
+#if defined(COLORED) || defined(TINT)
 uniform vec4 u_Color;
+#endif
+#if defined(TEXTURE_ARRAY) && !defined(COLORED)
+uniform sampler2DArray u_Texture;
+#elif !defined(COLORED)
 uniform sampler2D u_Texture;
+#endif
+#ifdef ALPHA_TEST
+uniform float u_AlphaCutoff;
+#endif
 
 void main()
 {
-    vec4 texColor = texture(u_Texture, v_TexCoord);
-    color = texColor;
+#ifdef COLORED
+    color = u_Color;
+#elif defined(TEXTURE_ARRAY)
+    color = texture(u_Texture, vec3(v_TexCoord, v_Layer));
+#else
+    color = texture(u_Texture, v_TexCoord);
+#endif
+#ifdef TINT
+    color *= u_Color;
+#endif
+#ifdef ALPHA_TEST
+    if (color.a < u_AlphaCutoff)
+        discard;
+#endif
 }
@@ -0,0 +1,8 @@
+//Shared by every shader, filled once per frame by CameraBuffer
+//Pull it in with #include "camera.glsl" after #version
+layout(std140) uniform Camera
+{
+    mat4 u_View;
+    mat4 u_Projection;
+    mat4 u_ViewProjection;
+};
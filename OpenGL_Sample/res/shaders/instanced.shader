@@ -0,0 +1,31 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 texCoord;
+//Per instance, takes up locations 2 through 5 (one per column)
+layout(location = 2) in mat4 a_Model;
+
+out vec2 v_TexCoord;
+
+#include "camera.glsl"
+
+void main()
+{
+    gl_Position = u_ViewProjection * a_Model * position;
+    v_TexCoord = texCoord;
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Texture;
+
+void main()
+{
+    color = texture(u_Texture, v_TexCoord);
+}
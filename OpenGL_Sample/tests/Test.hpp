@@ -42,6 +42,18 @@ namespace test {
             std::cout << "Registering test " << name << std::endl;
             m_Tests.push_back(std::make_pair(name, []() {return new T();}));
         }
+        
+        //Same test class registered more than once with different constructor arguments, e.g. one entry per setting to benchmark
+        //Arguments are copied into the factory, so nothing has to stay alive for it
+        template<typename T, typename... Args>
+        void RegisterTest(const std::string& name, Args... args)
+        {
+            std::cout << "Registering test " << name << std::endl;
+            m_Tests.push_back(std::make_pair(name, [=]() {return new T(args...);}));
+        }
+        
+        //Everything registered so far, lets headless mode create tests without going through the menu
+        inline const std::vector<std::pair<std::string, std::function<Test*()>>>& GetTests() const { return m_Tests; }
     private:
         //Store names and pointers to tests
         //Can't use straight pointer for 2nd arg in pair because tests don't exist yet. We want to crate them. Would have to create tests at beginning of application
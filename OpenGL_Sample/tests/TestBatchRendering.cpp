@@ -0,0 +1,84 @@
+//
+//  TestBatchRendering.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TestBatchRendering.hpp"
+
+#include <cmath>
+
+namespace test {
+
+    TestBatchRendering::TestBatchRendering()
+        : m_QuadCount(10000), m_Rotation(0.0f)
+    {
+        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        GLCall(glEnable(GL_BLEND));
+        
+        m_BatchRenderer = std::make_unique<BatchRenderer>();
+        
+        m_Shader = std::make_unique<Shader>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/basic.shader");
+        m_Shader->Bind();
+        m_Shader->SetUniform1i("u_Texture", 0);
+        //Vertices are already in world space
+        m_Shader->SetUniformMat4f("u_Model", glm::mat4(1.0f));
+        
+        m_Camera = std::make_unique<CameraBuffer>();
+        
+        m_Texture = TextureCache::Get().Load("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.png");
+    }
+
+    TestBatchRendering::~TestBatchRendering()
+    {
+    }
+
+    void TestBatchRendering::OnUpdate(float deltaTime)
+    {
+        m_Rotation += deltaTime;
+    }
+
+    void TestBatchRendering::OnRender()
+    {
+        GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        
+        m_BatchRenderer->BeginFrame();
+        
+        //Only the camera block changes per frame, u_Model stays identity since vertices are already in world space
+        m_Camera->Set(m_View, m_Proj);
+        m_Texture->Bind();
+        
+        //Square grid just big enough to hold every quad
+        int columns = (int)std::ceil(std::sqrt((float)m_QuadCount));
+        float cellWidth = 960.0f / columns;
+        float cellHeight = 540.0f / columns;
+        glm::vec2 size(cellWidth * 0.9f, cellHeight * 0.9f);
+        
+        m_BatchRenderer->BeginBatch(*m_Shader);
+        for (int i = 0; i < m_QuadCount; i++)
+        {
+            glm::vec3 position((i % columns + 0.5f) * cellWidth, (i / columns + 0.5f) * cellHeight, 0.0f);
+            if (m_Rotation != 0.0f)
+            {
+                glm::mat4 transform = glm::rotate(glm::translate(glm::mat4(1.0f), position), m_Rotation, glm::vec3(0, 0, 1));
+                m_BatchRenderer->SubmitQuad(transform, size);
+            }
+            else
+                m_BatchRenderer->SubmitQuad(position, size);
+        }
+        m_BatchRenderer->EndBatch();
+    }
+
+    void TestBatchRendering::OnImGuiRender()
+    {
+        const BatchStats& stats = m_BatchRenderer->GetStats();
+        ImGui::SliderInt("Quads", &m_QuadCount, 1, 50000);
+        ImGui::Text("Quads: %u", stats.QuadCount);
+        ImGui::Text("Draw calls: %u (batch size %u)", stats.DrawCalls, m_BatchRenderer->GetMaxQuads());
+        ImGui::Text("Draw calls saved: %u", stats.GetDrawCallsSaved());
+        ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    }
+
+}
@@ -0,0 +1,52 @@
+//
+//  TestBatchRendering.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TestBatchRendering_hpp
+#define TestBatchRendering_hpp
+
+#include "Test.hpp"
+
+#include <memory>
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "BatchRenderer.hpp"
+#include "CameraBuffer.hpp"
+#include "Texture.hpp"
+#include "TextureCache.hpp"
+
+namespace test {
+
+    //Fills the screen with a grid of textured quads drawn through the BatchRenderer
+    class TestBatchRendering: public Test
+    {
+    public:
+        TestBatchRendering();
+        ~TestBatchRendering();
+        
+        void OnUpdate(float deltaTime) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+    private:
+        std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<CameraBuffer> m_Camera;
+        std::shared_ptr<Texture> m_Texture;
+        
+        glm::mat4 m_Proj = glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f);
+        glm::mat4 m_View = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
+        
+        int m_QuadCount;
+        float m_Rotation;
+    };
+
+}
+
+#endif /* TestBatchRendering_hpp */
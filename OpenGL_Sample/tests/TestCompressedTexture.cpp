@@ -0,0 +1,142 @@
+//
+//  TestCompressedTexture.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TestCompressedTexture.hpp"
+#include "TextureCompressor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+namespace test {
+    
+    TestCompressedTexture::TestCompressedTexture()
+        : m_DecodedLoadMs(0.0f), m_CompressedLoadMs(0.0f), m_FlipError(-1)
+    {
+        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        GLCall(glEnable(GL_BLEND));
+        
+        m_BatchRenderer = std::make_unique<BatchRenderer>();
+        
+        m_Shader = std::make_unique<Shader>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/basic.shader");
+        m_Shader->Bind();
+        m_Shader->SetUniform1i("u_Texture", 0);
+        //Vertices are already in world space
+        m_Shader->SetUniformMat4f("u_Model", glm::mat4(1.0f));
+        
+        m_Camera = std::make_unique<CameraBuffer>();
+        m_Camera->Set(glm::mat4(1.0f), glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f));
+        
+        LoadTextures();
+        m_FlipError = CheckOddHeightFlip();
+    }
+    
+    TestCompressedTexture::~TestCompressedTexture()
+    {
+    }
+    
+    //Includes the upload, glFinish so the driver can't hide it
+    template<typename F>
+    static float TimeLoad(F load)
+    {
+        auto start = std::chrono::steady_clock::now();
+        load();
+        GLCall(glFinish());
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    void TestCompressedTexture::LoadTextures()
+    {
+        //Compressed textures can't generate mipmaps, bananas.ktx2 has them in the file, so the PNG gets them too to be fair
+        TextureOptions options;
+        options.Mipmaps = MipmapMode::GPU;
+        
+        m_DecodedLoadMs = TimeLoad([&]() {
+            m_Decoded = std::make_unique<Texture>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.png", options);
+        });
+        m_CompressedLoadMs = TimeLoad([&]() {
+            m_Compressed = std::make_unique<Texture>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.ktx2", options);
+        });
+    }
+    
+    int TestCompressedTexture::CheckOddHeightFlip()
+    {
+        const int width = 64, height = 6;
+        std::vector<unsigned char> pixels(width * height * 4);
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                unsigned char* pixel = &pixels[(y * width + x) * 4];
+                pixel[0] = pixel[1] = pixel[2] = (unsigned char)(y * 50);
+                pixel[3] = 255;
+            }
+        }
+        CompressedImage image = TextureCompressor::Compress(pixels.data(), width, height, false);
+        if (!CompressedImage::IsFormatSupported(image.Format))
+            return -1;
+        Texture texture(image);
+        
+        //The driver decodes it for us, rows come back bottom first so row y should match row height - 1 - y
+        std::vector<unsigned char> decoded(pixels.size());
+        texture.Bind();
+        GLCall(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, decoded.data()));
+        texture.Unbind();
+        int maxError = 0;
+        for (int y = 0; y < height; y++)
+            for (int i = 0; i < width * 4; i++)
+                maxError = std::max(maxError, std::abs(decoded[y * width * 4 + i] - pixels[(height - 1 - y) * width * 4 + i]));
+        return maxError;
+    }
+    
+    void TestCompressedTexture::OnUpdate(float deltaTime)
+    {
+    }
+    
+    void TestCompressedTexture::OnRender()
+    {
+        GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        
+        m_BatchRenderer->BeginFrame();
+        
+        //One batch per texture, same size and aspect as the image
+        glm::vec2 size(440.0f, 330.0f);
+        m_Decoded->Bind();
+        m_BatchRenderer->BeginBatch(*m_Shader);
+        m_BatchRenderer->SubmitQuad(glm::vec3(250.0f, 270.0f, 0.0f), size);
+        m_BatchRenderer->EndBatch();
+        
+        m_Compressed->Bind();
+        m_BatchRenderer->BeginBatch(*m_Shader);
+        m_BatchRenderer->SubmitQuad(glm::vec3(710.0f, 270.0f, 0.0f), size);
+        m_BatchRenderer->EndBatch();
+    }
+    
+    static void ShowTexture(const char* label, const Texture& texture, float loadMs)
+    {
+        const char* format = texture.IsCompressed() ? CompressedImage::GetFormatName(texture.GetFormat()) : "RGBA8";
+        ImGui::Text("%s: %s, %d level(s), %.0f KB, loaded in %.1f ms", label, format, texture.GetMipLevels(),
+            texture.GetMemorySize() / 1024.0f, loadMs);
+    }
+    
+    void TestCompressedTexture::OnImGuiRender()
+    {
+        ShowTexture("Left (PNG)", *m_Decoded, m_DecodedLoadMs);
+        ShowTexture("Right (KTX2)", *m_Compressed, m_CompressedLoadMs);
+        if (!m_Compressed->IsCompressed())
+            ImGui::Text("bananas.ktx2 couldn't be used, run with --compress-textures to make it");
+        //A few levels of error is just BC1, a flip that went wrong is off by whole rows (50 or more)
+        if (m_FlipError >= 0)
+            ImGui::Text("64x6 BC1 flip check: largest error %d (%s)", m_FlipError, m_FlipError < 25 ? "ok" : "rows out of place");
+        if (ImGui::Button("Reload"))
+            LoadTextures();
+        ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    }
+
+}
@@ -0,0 +1,58 @@
+//
+//  TestCompressedTexture.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TestCompressedTexture_hpp
+#define TestCompressedTexture_hpp
+
+#include "Test.hpp"
+
+#include <memory>
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "BatchRenderer.hpp"
+#include "CameraBuffer.hpp"
+#include "Texture.hpp"
+
+namespace test {
+    
+    //The same image as a PNG (decoded to RGBA8) and as a KTX2 (uploaded still compressed), side by side
+    //Shows what each costs in load time and video memory. res/textures/bananas.ktx2 comes from --compress-textures
+    class TestCompressedTexture: public Test
+    {
+    public:
+        TestCompressedTexture();
+        ~TestCompressedTexture();
+        
+        void OnUpdate(float deltaTime) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+    private:
+        //Loads both again, timing each
+        void LoadTextures();
+        //Compresses a 64x6 gradient top row first, uploads it (which flips it) and compares what GL decodes with the original
+        //6 rows leaves a partial block row, the case FlipVertically can't do by moving rows. Returns the largest channel error
+        static int CheckOddHeightFlip();
+        
+        std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<CameraBuffer> m_Camera;
+        std::unique_ptr<Texture> m_Decoded;
+        std::unique_ptr<Texture> m_Compressed;
+        
+        float m_DecodedLoadMs;
+        float m_CompressedLoadMs;
+        //-1 if the driver can't sample BC1
+        int m_FlipError;
+    };
+
+}
+
+#endif /* TestCompressedTexture_hpp */
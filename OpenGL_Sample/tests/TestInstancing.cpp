@@ -0,0 +1,105 @@
+//
+//  TestInstancing.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TestInstancing.hpp"
+
+#include <cmath>
+
+namespace test {
+
+    static const int s_MaxInstances = 10000;
+
+    TestInstancing::TestInstancing()
+        : m_InstanceCount(1000), m_Time(0.0f)
+    {
+        //Same 100x100 px quad as TestTexture2D
+        float positions[] {
+            -50.0f, -50.0f, 0.0f, 0.0f, //Index 0
+             50.0f, -50.0f, 1.0f, 0.0f, //Index 1
+             50.0f,  50.0f, 1.0f, 1.0f, //Index 2
+            -50.0f,  50.0f, 0.0f, 1.0f  //Index 3
+        };
+
+        unsigned int indices[] = {
+            0, 1, 2,
+            2, 3, 0
+        };
+
+        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        GLCall(glEnable(GL_BLEND));
+        
+        m_VAO = std::make_unique<VertexArray>();
+
+        m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+        VertexBufferLayout layout;
+        layout.Push<float>(2);
+        layout.Push<float>(2);
+        m_VAO->AddBuffer(*m_VertexBuffer, layout);
+        
+        //Second buffer on the same vertex array, picks up at attribute 2
+        //Divisor of 1 means the matrix moves forward once per instance instead of once per vertex
+        m_InstanceBuffer = std::make_unique<VertexBuffer>(s_MaxInstances * (unsigned int)sizeof(glm::mat4));
+        VertexBufferLayout instanceLayout;
+        instanceLayout.Push<glm::mat4>(1, 1);
+        m_VAO->AddBuffer(*m_InstanceBuffer, instanceLayout);
+        
+        m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+        m_Models.resize(s_MaxInstances);
+
+        m_shader = std::make_unique<Shader>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/instanced.shader");
+        m_shader->Bind();
+        m_shader->SetUniform1i("u_Texture", 0);
+
+        m_Camera = std::make_unique<CameraBuffer>();
+
+        m_Texture = TextureCache::Get().Load("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.png");
+    }
+
+    TestInstancing::~TestInstancing()
+    {
+    }
+
+    void TestInstancing::OnUpdate(float deltaTime)
+    {
+        m_Time += deltaTime;
+    }
+
+    void TestInstancing::OnRender()
+    {
+        GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        
+        Renderer renderer;
+        
+        //Spread the instances over the screen on a grid, scaled down so they all fit
+        int columns = (int)std::ceil(std::sqrt((float)m_InstanceCount));
+        float cellWidth = 960.0f / columns;
+        float cellHeight = 540.0f / columns;
+        float scale = std::fmin(cellWidth, cellHeight) / 100.0f;
+        for (int i = 0; i < m_InstanceCount; i++)
+        {
+            glm::vec3 position((i % columns + 0.5f) * cellWidth, (i / columns + 0.5f) * cellHeight, 0.0f);
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+            model = glm::rotate(model, m_Time + i * 0.01f, glm::vec3(0, 0, 1));
+            m_Models[i] = glm::scale(model, glm::vec3(scale, scale, 1.0f));
+        }
+        m_InstanceBuffer->SetData(m_Models.data(), m_InstanceCount * (unsigned int)sizeof(glm::mat4));
+        
+        //View projection comes from the shared camera block, so there are no uniform uploads at all
+        m_Camera->Set(m_View, m_Proj);
+        m_Texture->Bind();
+        renderer.DrawInstanced(*m_VAO, *m_IndexBuffer, *m_shader, m_InstanceCount);
+    }
+
+    void TestInstancing::OnImGuiRender()
+    {
+        ImGui::SliderInt("Instances", &m_InstanceCount, 1, s_MaxInstances);
+        ImGui::Text("Draw calls: 1");
+        ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    }
+
+}
@@ -0,0 +1,59 @@
+//
+//  TestInstancing.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TestInstancing_hpp
+#define TestInstancing_hpp
+
+#include "Test.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "VertexBuffer.hpp"
+#include "VertexBufferLayout.hpp"
+#include "Texture.hpp"
+#include "TextureCache.hpp"
+#include "CameraBuffer.hpp"
+
+namespace test {
+
+    //Same quad as TestTexture2D, but every copy comes from a single glDrawElementsInstanced call
+    class TestInstancing: public Test
+    {
+    public:
+        TestInstancing();
+        ~TestInstancing();
+        
+        void OnUpdate(float deltaTime) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+    private:
+        std::unique_ptr<VertexArray> m_VAO;
+        std::unique_ptr<IndexBuffer> m_IndexBuffer;
+        std::unique_ptr<Shader> m_shader;
+        std::unique_ptr<CameraBuffer> m_Camera;
+        std::shared_ptr<Texture> m_Texture;
+        std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        //One model matrix per instance
+        std::unique_ptr<VertexBuffer> m_InstanceBuffer;
+        
+        glm::mat4 m_Proj = glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f);
+        glm::mat4 m_View = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
+        
+        std::vector<glm::mat4> m_Models;
+        int m_InstanceCount;
+        float m_Time;
+    };
+
+}
+
+#endif /* TestInstancing_hpp */
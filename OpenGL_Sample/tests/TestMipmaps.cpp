@@ -0,0 +1,107 @@
+//
+//  TestMipmaps.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TestMipmaps.hpp"
+
+namespace test {
+    
+    TestMipmaps::TestMipmaps(MipmapMode mode)
+        : m_QuadSize(8.0f), m_Tilt(0.0f)
+    {
+        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        GLCall(glEnable(GL_BLEND));
+        
+        m_BatchRenderer = std::make_unique<BatchRenderer>();
+        
+        m_Shader = std::make_unique<Shader>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/basic.shader");
+        m_Shader->Bind();
+        m_Shader->SetUniform1i("u_Texture", 0);
+        //Vertices are already in world space
+        m_Shader->SetUniformMat4f("u_Model", glm::mat4(1.0f));
+        
+        m_Camera = std::make_unique<CameraBuffer>();
+        
+        m_Options.Mipmaps = mode;
+        LoadTexture();
+    }
+    
+    TestMipmaps::~TestMipmaps()
+    {
+    }
+    
+    void TestMipmaps::LoadTexture()
+    {
+        m_Texture = std::make_unique<Texture>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.png", m_Options);
+    }
+    
+    void TestMipmaps::OnUpdate(float deltaTime)
+    {
+    }
+    
+    void TestMipmaps::OnRender()
+    {
+        GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        
+        m_BatchRenderer->BeginFrame();
+        
+        //Camera far enough back that the untilted 960x540 plane exactly fills a 60 degree view
+        float fov = glm::radians(60.0f);
+        float distance = 270.0f / std::tan(fov * 0.5f);
+        glm::mat4 proj = glm::perspective(fov, 960.0f / 540.0f, 1.0f, 10000.0f);
+        glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -distance));
+        view = glm::rotate(view, glm::radians(-m_Tilt), glm::vec3(1, 0, 0));
+        view = glm::translate(view, glm::vec3(-480.0f, -270.0f, 0.0f));
+        m_Camera->Set(view, proj);
+        m_Texture->Bind();
+        
+        //Grid over the plane, tilting it makes the far rows much smaller (and the plane taller) so stretch it
+        float stretch = 1.0f / std::max(std::cos(glm::radians(m_Tilt)), 0.1f);
+        float cell = m_QuadSize * 1.25f;
+        int columns = (int)(960.0f / cell);
+        int rows = (int)(540.0f * stretch / cell);
+        glm::vec2 size(m_QuadSize, m_QuadSize);
+        
+        m_BatchRenderer->BeginBatch(*m_Shader);
+        for (int y = 0; y < rows; y++)
+            for (int x = 0; x < columns; x++)
+                m_BatchRenderer->SubmitQuad(glm::vec3((x + 0.5f) * cell, (y + 0.5f) * cell, 0.0f), size);
+        m_BatchRenderer->EndBatch();
+    }
+    
+    void TestMipmaps::OnImGuiRender()
+    {
+        static const char* s_Modes[] = { "Off", "GPU (glGenerateMipmap)", "CPU box filter" };
+        int mode = (int)m_Options.Mipmaps;
+        if (ImGui::Combo("Mipmaps", &mode, s_Modes, 3))
+        {
+            m_Options.Mipmaps = (MipmapMode)mode;
+            LoadTexture();
+        }
+        
+        bool samplingChanged = ImGui::Checkbox("Trilinear", &m_Options.Trilinear);
+        float maxAnisotropy = Texture::GetMaxAnisotropy();
+        if (maxAnisotropy > 1.0f)
+            samplingChanged |= ImGui::SliderFloat("Anisotropy", &m_Options.Anisotropy, 1.0f, maxAnisotropy);
+        else
+            ImGui::Text("Anisotropic filtering not supported");
+        if (samplingChanged)
+            m_Texture->SetSampling(m_Options.Trilinear, m_Options.Anisotropy);
+        
+        ImGui::SliderFloat("Quad size", &m_QuadSize, 2.0f, 128.0f);
+        ImGui::SliderFloat("Tilt", &m_Tilt, 0.0f, 85.0f);
+        
+        //Full chain is a third bigger than level 0 on its own
+        float levelZeroKB = m_Texture->GetWidth() * m_Texture->GetHeight() * 4 / 1024.0f;
+        ImGui::Text("%dx%d, %d mip level(s), ~%.0f KB", m_Texture->GetWidth(), m_Texture->GetHeight(), m_Texture->GetMipLevels(),
+            m_Texture->GetMipLevels() > 1 ? levelZeroKB * 4.0f / 3.0f : levelZeroKB);
+        const BatchStats& stats = m_BatchRenderer->GetStats();
+        ImGui::Text("Quads: %u in %u draw call(s)", stats.QuadCount, stats.DrawCalls);
+        ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    }
+
+}
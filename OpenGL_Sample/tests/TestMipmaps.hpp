@@ -0,0 +1,55 @@
+//
+//  TestMipmaps.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TestMipmaps_hpp
+#define TestMipmaps_hpp
+
+#include "Test.hpp"
+
+#include <memory>
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "BatchRenderer.hpp"
+#include "CameraBuffer.hpp"
+#include "Texture.hpp"
+
+namespace test {
+    
+    //A plane covered in small copies of a big texture, optionally tilted away from the camera
+    //Without mipmaps every tiny quad samples texels spread across the whole image, which is slow and shimmers
+    //Registered once per MipmapMode so --benchmark can compare the GPU time of each
+    class TestMipmaps: public Test
+    {
+    public:
+        TestMipmaps(MipmapMode mode = MipmapMode::GPU);
+        ~TestMipmaps();
+        
+        void OnUpdate(float deltaTime) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+    private:
+        void LoadTexture();
+        
+        std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<CameraBuffer> m_Camera;
+        std::unique_ptr<Texture> m_Texture;
+        
+        TextureOptions m_Options;
+        //On screen size of each quad in pixels when the plane isn't tilted
+        float m_QuadSize;
+        //Degrees the plane leans back, anisotropic filtering only matters once this isn't 0
+        float m_Tilt;
+    };
+
+}
+
+#endif /* TestMipmaps_hpp */
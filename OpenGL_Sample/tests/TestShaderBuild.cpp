@@ -0,0 +1,145 @@
+//
+//  TestShaderBuild.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TestShaderBuild.hpp"
+
+#include "ShaderBuildQueue.hpp"
+#include "ShaderCache.hpp"
+
+#include <string>
+
+namespace test {
+
+    static double MillisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static void InsertAfterVersion(std::string& source, const std::string& line)
+    {
+        size_t version = source.find("#version");
+        if (version == std::string::npos)
+            return;
+        size_t end = source.find('\n', version);
+        source.insert(end == std::string::npos ? source.size() : end + 1, line);
+    }
+
+    TestShaderBuild::TestShaderBuild()
+        : m_Salt(0), m_CacheWasEnabled(ShaderCache::IsEnabled()), m_ShaderCount(32), m_Failed(0),
+          m_OneAtATimeMs(0.0), m_QueuedMs(0.0), m_BackgroundMs(0.0), m_BackgroundPending(0)
+    {
+        m_Source = Shader::ParseShader("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/basic.shader");
+        //Start from the clock so a second run of the app doesn't hit the driver's own disk cache either
+        m_Salt = (unsigned long long)std::chrono::steady_clock::now().time_since_epoch().count();
+        //Every build here would be a hit after the first click otherwise
+        ShaderCache::SetEnabled(false);
+    }
+
+    TestShaderBuild::~TestShaderBuild()
+    {
+        for (uint64_t id : m_BackgroundBuilds)
+            ShaderBuildQueue::Get().Cancel(id);
+        ShaderCache::SetEnabled(m_CacheWasEnabled);
+    }
+
+    ShaderProgramSouce TestShaderBuild::MakeUniqueSource()
+    {
+        ShaderProgramSouce source = m_Source;
+        std::string salt = "//build " + std::to_string(m_Salt++) + "\n";
+        InsertAfterVersion(source.VertexSource, salt);
+        InsertAfterVersion(source.FragmentSource, salt);
+        return source;
+    }
+
+    void TestShaderBuild::OnBuilt(unsigned int program)
+    {
+        if (program)
+        {
+            GLCall(glDeleteProgram(program));
+        }
+        else
+            m_Failed++;
+    }
+
+    void TestShaderBuild::BuildOneAtATime()
+    {
+        //What creating Shader objects back to back used to cost, every build waited on before the next starts
+        auto start = std::chrono::steady_clock::now();
+        ShaderBuildQueue queue;
+        for (int i = 0; i < m_ShaderCount; i++)
+        {
+            queue.Submit("one at a time", MakeUniqueSource(), [this](unsigned int program) { OnBuilt(program); });
+            queue.Finish();
+        }
+        m_OneAtATimeMs = MillisecondsSince(start);
+    }
+
+    void TestShaderBuild::BuildQueued()
+    {
+        auto start = std::chrono::steady_clock::now();
+        ShaderBuildQueue queue;
+        for (int i = 0; i < m_ShaderCount; i++)
+            queue.Submit("queued", MakeUniqueSource(), [this](unsigned int program) { OnBuilt(program); });
+        queue.Finish();
+        m_QueuedMs = MillisecondsSince(start);
+    }
+
+    void TestShaderBuild::BuildInBackground()
+    {
+        //Still running from last click
+        if (m_BackgroundPending)
+            return;
+        m_BackgroundStart = std::chrono::steady_clock::now();
+        m_BackgroundBuilds.clear();
+        m_BackgroundPending = m_ShaderCount;
+        for (int i = 0; i < m_ShaderCount; i++)
+        {
+            m_BackgroundBuilds.push_back(ShaderBuildQueue::Get().Submit("background", MakeUniqueSource(), [this](unsigned int program)
+            {
+                OnBuilt(program);
+                if (--m_BackgroundPending == 0)
+                    m_BackgroundMs = MillisecondsSince(m_BackgroundStart);
+            }));
+        }
+    }
+
+    void TestShaderBuild::OnUpdate(float deltaTime)
+    {
+    }
+
+    void TestShaderBuild::OnRender()
+    {
+        GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+    }
+
+    void TestShaderBuild::OnImGuiRender()
+    {
+        ImGui::Text("Parallel compile (KHR_parallel_shader_compile): %s", ShaderBuildQueue::IsParallel() ? "yes" : "no");
+        ImGui::SliderInt("Programs", &m_ShaderCount, 1, 256);
+        
+        if (ImGui::Button("Build one at a time"))
+            BuildOneAtATime();
+        ImGui::SameLine();
+        if (ImGui::Button("Build through queue"))
+            BuildQueued();
+        ImGui::SameLine();
+        if (ImGui::Button("Build in background"))
+            BuildInBackground();
+        
+        ImGui::Text("One at a time: %.2f ms", m_OneAtATimeMs);
+        ImGui::Text("Queue + Finish: %.2f ms", m_QueuedMs);
+        if (m_BackgroundPending)
+            ImGui::Text("Background: %u still building", m_BackgroundPending);
+        else
+            ImGui::Text("Background: %.2f ms until the last one was ready", m_BackgroundMs);
+        if (m_Failed)
+            ImGui::Text("Failed builds: %u (see console)", m_Failed);
+        ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    }
+
+}
@@ -0,0 +1,62 @@
+//
+//  TestShaderBuild.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TestShaderBuild_hpp
+#define TestShaderBuild_hpp
+
+#include "Test.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+
+#include "Shader.hpp"
+
+namespace test {
+
+    //Times building a pile of programs one at a time against submitting them all to a ShaderBuildQueue first
+    //Like a scene loading lots of materials at once, the gap is how much the driver's compiler threads buy us
+    class TestShaderBuild: public Test
+    {
+    public:
+        TestShaderBuild();
+        ~TestShaderBuild();
+        
+        void OnUpdate(float deltaTime) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+    private:
+        //basic.shader with a unique comment after each #version, so neither our cache nor the driver's can skip the compile
+        ShaderProgramSouce MakeUniqueSource();
+        //Every program is thrown away as soon as it's built, only the timing matters
+        void OnBuilt(unsigned int program);
+        
+        void BuildOneAtATime();
+        void BuildQueued();
+        void BuildInBackground();
+        
+        ShaderProgramSouce m_Source;
+        unsigned long long m_Salt;
+        bool m_CacheWasEnabled;
+        int m_ShaderCount;
+        unsigned int m_Failed;
+        
+        double m_OneAtATimeMs;
+        double m_QueuedMs;
+        //Background builds finish from the shared queue's Update in the main loop, over several frames
+        double m_BackgroundMs;
+        std::vector<uint64_t> m_BackgroundBuilds;
+        unsigned int m_BackgroundPending;
+        std::chrono::steady_clock::time_point m_BackgroundStart;
+    };
+
+}
+
+#endif /* TestShaderBuild_hpp */
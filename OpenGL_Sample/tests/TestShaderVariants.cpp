@@ -0,0 +1,108 @@
+//
+//  TestShaderVariants.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TestShaderVariants.hpp"
+
+namespace test {
+
+    TestShaderVariants::TestShaderVariants()
+        : m_Features{ false, false, false }, m_ShowAll(false), m_Color(1.0f, 0.5f, 0.2f, 1.0f), m_AlphaCutoff(0.5f)
+    {
+        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        GLCall(glEnable(GL_BLEND));
+        
+        m_BatchRenderer = std::make_unique<BatchRenderer>();
+        m_Variants = std::make_unique<ShaderVariants>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/basic.shader");
+        m_Camera = std::make_unique<CameraBuffer>();
+        m_Texture = TextureCache::Get().Load("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.png");
+    }
+
+    TestShaderVariants::~TestShaderVariants()
+    {
+    }
+
+    Shader& TestShaderVariants::GetVariant(uint32_t mask)
+    {
+        bool built = m_Variants->IsBuilt(mask);
+        Shader& shader = m_Variants->Get(mask);
+        if (built)
+            return shader;
+        
+        //Only set what this variant declares, the rest are compiled out and would just warn
+        shader.Bind();
+        //Vertices are already in world space
+        shader.SetUniformMat4f("u_Model", glm::mat4(1.0f));
+        if (!(mask & ShaderFeature_Colored))
+            shader.SetUniform1i("u_Texture", 0);
+        SetColorUniforms(shader, mask);
+        return shader;
+    }
+
+    void TestShaderVariants::SetColorUniforms(Shader& shader, uint32_t mask)
+    {
+        shader.Bind();
+        if (mask & (ShaderFeature_Colored | ShaderFeature_Tint))
+            shader.SetUniform4f("u_Color", m_Color.r, m_Color.g, m_Color.b, m_Color.a);
+        if (mask & ShaderFeature_AlphaTest)
+            shader.SetUniform1f("u_AlphaCutoff", m_AlphaCutoff);
+    }
+
+    void TestShaderVariants::OnUpdate(float deltaTime)
+    {
+    }
+
+    void TestShaderVariants::OnRender()
+    {
+        GLCall(glClearColor(0.1f, 0.1f, 0.1f, 1.0f));
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        
+        m_BatchRenderer->BeginFrame();
+        m_Camera->Set(m_View, m_Proj);
+        m_Texture->Bind();
+        
+        uint32_t checked = 0;
+        for (int i = 0; i < 3; i++)
+            if (m_Features[i])
+                checked |= 1u << i;
+        
+        //4x2 grid with one cell per mask, or a single quad for the checked one
+        unsigned int count = m_ShowAll ? m_Variants->GetPossibleCount() : 1;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            uint32_t mask = m_ShowAll ? i : checked;
+            glm::vec3 position = m_ShowAll ? glm::vec3(120.0f + (i % 4) * 240.0f, 135.0f + (i / 4) * 270.0f, 0.0f) : glm::vec3(480.0f, 270.0f, 0.0f);
+            glm::vec2 size = m_ShowAll ? glm::vec2(200.0f, 200.0f) : glm::vec2(400.0f, 400.0f);
+            
+            m_BatchRenderer->BeginBatch(GetVariant(mask));
+            m_BatchRenderer->SubmitQuad(position, size);
+            m_BatchRenderer->EndBatch();
+        }
+    }
+
+    void TestShaderVariants::OnImGuiRender()
+    {
+        const std::vector<std::string>& features = ShaderVariants::GetDefaultFeatures();
+        for (int i = 0; i < 3; i++)
+        {
+            ImGui::Checkbox(features[i].c_str(), &m_Features[i]);
+            if (i < 2)
+                ImGui::SameLine();
+        }
+        ImGui::Checkbox("Show every combination", &m_ShowAll);
+        
+        bool colorChanged = ImGui::ColorEdit4("u_Color", &m_Color.r);
+        bool cutoffChanged = ImGui::SliderFloat("u_AlphaCutoff", &m_AlphaCutoff, 0.0f, 1.0f);
+        //Uniforms live in each program, so every variant built so far needs the new value
+        if (colorChanged || cutoffChanged)
+            for (const auto& variant : m_Variants->GetBuilt())
+                SetColorUniforms(*variant.second, variant.first);
+        
+        ImGui::Text("Variants compiled: %u of %u", m_Variants->GetBuiltCount(), m_Variants->GetPossibleCount());
+        ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    }
+
+}
@@ -0,0 +1,61 @@
+//
+//  TestShaderVariants.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TestShaderVariants_hpp
+#define TestShaderVariants_hpp
+
+#include "Test.hpp"
+
+#include <memory>
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "BatchRenderer.hpp"
+#include "CameraBuffer.hpp"
+#include "ShaderVariants.hpp"
+#include "Texture.hpp"
+#include "TextureCache.hpp"
+
+namespace test {
+
+    //basic.shader drawn with different feature masks, variants only get compiled once something draws with them
+    class TestShaderVariants: public Test
+    {
+    public:
+        TestShaderVariants();
+        ~TestShaderVariants();
+        
+        void OnUpdate(float deltaTime) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+    private:
+        //Builds the variant the first time and sets the uniforms it uses, they then stay put in the program
+        Shader& GetVariant(uint32_t mask);
+        void SetColorUniforms(Shader& shader, uint32_t mask);
+        
+        std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        std::unique_ptr<ShaderVariants> m_Variants;
+        std::unique_ptr<CameraBuffer> m_Camera;
+        std::shared_ptr<Texture> m_Texture;
+        
+        glm::mat4 m_Proj = glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f);
+        glm::mat4 m_View = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
+        
+        //One checkbox per ShaderFeature bit
+        bool m_Features[3];
+        //Every combination side by side instead of just the checked one
+        bool m_ShowAll;
+        glm::vec4 m_Color;
+        float m_AlphaCutoff;
+    };
+
+}
+
+#endif /* TestShaderVariants_hpp */
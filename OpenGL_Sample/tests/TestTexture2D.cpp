@@ -51,6 +51,12 @@ namespace test {
         layout.Push<float>(2);
         m_VAO->AddBuffer(*m_VertexBuffer, layout);
         
+        //Model matrix of each quad, one per instance
+        m_InstanceBuffer = std::make_unique<VertexBuffer>(2 * (unsigned int)sizeof(glm::mat4));
+        VertexBufferLayout instanceLayout;
+        instanceLayout.Push<glm::mat4>(1, 1);
+        m_VAO->AddBuffer(*m_InstanceBuffer, instanceLayout);
+        
         //ibo - index buffer object
         //Cherno using unsigned ints here because will use in future
         //and no measureable performance difference for this example
@@ -64,11 +70,14 @@ namespace test {
         //Take our coordinate and convert it to a space between -1 and 1
         glm::vec4 result = m_Proj*vp;
 
-        m_shader = std::make_unique<Shader>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/basic.shader");
+        //Model matrices come in as instance data and view projection from the camera block, so no per draw uniforms
+        m_shader = std::make_unique<Shader>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/instanced.shader");
         m_shader->Bind();
-        m_shader->SetUniform4f("u_Color", 0.8f, 0.3f, 0.8f, 1.0f);
+        m_Camera = std::make_unique<CameraBuffer>();
 
-        m_Texture = std::make_unique<Texture>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.png");
+        //Decoded on a worker thread, draws with a placeholder until it's ready instead of stalling the first frame
+        //Cached, so opening the test again (or any other scene with bananas.png) reuses the same texture
+        m_Texture = TextureCache::Get().LoadAsync("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.png");
         //0 needs to match Bind arg
         //If called Bind(2), 2nd arg below would be 2
         m_shader->SetUniform1i("u_Texture", 0);
@@ -91,27 +100,15 @@ namespace test {
         
         m_Texture->Bind();
         
-        {
-            //Recalculating model matrix and mvp every frame
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), m_translationA);
-            //Model, view, projection matrix
-            glm::mat4 mvp = m_Proj * m_View * model;
-            //Need to bind to set uniforms
-            //Only need to do once since Draw binds shader and doesn't unbind
-            m_shader->Bind();
-            //Need to set MVP uniform
-            //Setting once is enough, but can set every frame if we want to
-            m_shader->SetUniformMat4f("u_MVP", mvp);
-            //Draw will bind shader and never unbind
-            renderer.Draw(*m_VAO, *m_IndexBuffer, *m_shader);
-        }
-
-        {
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), m_translationB);
-            glm::mat4 mvp = m_Proj * m_View * model;
-            m_shader->SetUniformMat4f("u_MVP", mvp);
-            renderer.Draw(*m_VAO, *m_IndexBuffer, *m_shader);
-        }
+        //Recalculating model matrices every frame, both quads then go in one instanced draw
+        glm::mat4 models[2] = {
+            glm::translate(glm::mat4(1.0f), m_translationA),
+            glm::translate(glm::mat4(1.0f), m_translationB)
+        };
+        m_InstanceBuffer->SetData(models, sizeof(models));
+        //Camera block holds the view and projection part of the MVP for every shader
+        m_Camera->Set(m_View, m_Proj);
+        renderer.DrawInstanced(*m_VAO, *m_IndexBuffer, *m_shader, 2);
     }
 
     void  TestTexture2D::OnImGuiRender()
@@ -20,6 +20,8 @@
 #include "VertexBuffer.hpp"
 #include "VertexBufferLayout.hpp"
 #include "Texture.hpp"
+#include "TextureCache.hpp"
+#include "CameraBuffer.hpp"
 
 namespace test {
 
@@ -36,8 +38,12 @@ namespace test {
         std::unique_ptr<VertexArray> m_VAO;
         std::unique_ptr<IndexBuffer> m_IndexBuffer;
         std::unique_ptr<Shader> m_shader;
-        std::unique_ptr<Texture> m_Texture;
+        //Shared with the TextureLoader until its image has been uploaded
+        std::shared_ptr<Texture> m_Texture;
         std::unique_ptr<VertexBuffer> m_VertexBuffer;
+        //Model matrices of the two quads
+        std::unique_ptr<VertexBuffer> m_InstanceBuffer;
+        std::unique_ptr<CameraBuffer> m_Camera;
         
         glm::mat4 m_Proj = glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f);
         //With coordinates of 0,0,0 view matrix isn't applying any transformation. Redundant.
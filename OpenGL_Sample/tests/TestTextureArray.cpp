@@ -0,0 +1,151 @@
+//
+//  TestTextureArray.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TestTextureArray.hpp"
+
+namespace test {
+    
+    static const int s_TileSize = 64;
+    static const int s_ImageCount = 64;
+    
+    //A border and a diagonal stripe, in a color of its own, so every image is easy to tell apart
+    static std::vector<unsigned char> GenerateTile(int index)
+    {
+        std::vector<unsigned char> pixels(s_TileSize * s_TileSize * 4);
+        unsigned char r = (unsigned char)(60 + (index * 97) % 196);
+        unsigned char g = (unsigned char)(60 + (index * 53) % 196);
+        unsigned char b = (unsigned char)(60 + (index * 151) % 196);
+        int stripe = 4 + index % 8;
+        for (int y = 0; y < s_TileSize; y++)
+        {
+            for (int x = 0; x < s_TileSize; x++)
+            {
+                unsigned char* pixel = &pixels[(y * s_TileSize + x) * 4];
+                bool border = x < 2 || y < 2 || x >= s_TileSize - 2 || y >= s_TileSize - 2;
+                bool dark = border || ((x + y) / stripe) % 2 == 0;
+                pixel[0] = dark ? r / 2 : r;
+                pixel[1] = dark ? g / 2 : g;
+                pixel[2] = dark ? b / 2 : b;
+                pixel[3] = 255;
+            }
+        }
+        return pixels;
+    }
+    
+    TestTextureArray::TestTextureArray()
+        : m_Columns(40), m_Rows(22), m_UseArray(true), m_Seed(1)
+    {
+        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        GLCall(glEnable(GL_BLEND));
+        
+        m_BatchRenderer = std::make_unique<BatchRenderer>();
+        
+        m_Shader = std::make_unique<Shader>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/basic.shader");
+        m_ArrayShader = std::make_unique<Shader>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/basic.shader", std::vector<std::string>{ "TEXTURE_ARRAY" });
+        for (Shader* shader : { m_Shader.get(), m_ArrayShader.get() })
+        {
+            shader->Bind();
+            shader->SetUniform1i("u_Texture", 0);
+            //Vertices are already in world space
+            shader->SetUniformMat4f("u_Model", glm::mat4(1.0f));
+        }
+        
+        m_Camera = std::make_unique<CameraBuffer>();
+        m_Camera->Set(glm::mat4(1.0f), glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f));
+        
+        //Same images both ways, tiles are drawn smaller than they are so mipmaps matter
+        TextureOptions options;
+        options.Mipmaps = MipmapMode::GPU;
+        m_Array = std::make_unique<TextureArray>(s_TileSize, s_TileSize, s_ImageCount, options);
+        for (int i = 0; i < s_ImageCount; i++)
+        {
+            std::vector<unsigned char> pixels = GenerateTile(i);
+            m_Array->SetLayer(i, pixels.data());
+            m_Textures.push_back(std::make_unique<Texture>(s_TileSize, s_TileSize, pixels.data(), options));
+        }
+        
+        ShuffleTiles();
+    }
+    
+    TestTextureArray::~TestTextureArray()
+    {
+    }
+    
+    void TestTextureArray::ShuffleTiles()
+    {
+        m_Tiles.resize(m_Columns * m_Rows);
+        for (unsigned int& tile : m_Tiles)
+        {
+            //Cheap LCG, only needs to look random
+            m_Seed = m_Seed * 1664525u + 1013904223u;
+            tile = (m_Seed >> 16) % s_ImageCount;
+        }
+    }
+    
+    void TestTextureArray::OnUpdate(float deltaTime)
+    {
+    }
+    
+    void TestTextureArray::OnRender()
+    {
+        GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        
+        m_BatchRenderer->BeginFrame();
+        
+        float cellWidth = 960.0f / m_Columns;
+        float cellHeight = 540.0f / m_Rows;
+        glm::vec2 size(cellWidth - 1.0f, cellHeight - 1.0f);
+        
+        if (m_UseArray)
+        {
+            //One bind, the layer in each vertex does the rest
+            m_Array->Bind();
+            m_BatchRenderer->BeginBatch(*m_ArrayShader);
+            for (unsigned int i = 0; i < m_Tiles.size(); i++)
+            {
+                glm::vec3 position((i % m_Columns + 0.5f) * cellWidth, (i / m_Columns + 0.5f) * cellHeight, 0.0f);
+                m_BatchRenderer->SubmitQuad(position, size, glm::vec2(0.0f), glm::vec2(1.0f), m_Tiles[i]);
+            }
+            m_BatchRenderer->EndBatch();
+            return;
+        }
+        
+        //Map order, so the batch only survives runs of the same image
+        //(sorting by texture would help here, but not once tiles overlap and draw order matters)
+        int bound = -1;
+        for (unsigned int i = 0; i < m_Tiles.size(); i++)
+        {
+            if ((int)m_Tiles[i] != bound)
+            {
+                if (bound >= 0)
+                    m_BatchRenderer->EndBatch();
+                bound = (int)m_Tiles[i];
+                m_Textures[bound]->Bind();
+                m_BatchRenderer->BeginBatch(*m_Shader);
+            }
+            glm::vec3 position((i % m_Columns + 0.5f) * cellWidth, (i / m_Columns + 0.5f) * cellHeight, 0.0f);
+            m_BatchRenderer->SubmitQuad(position, size);
+        }
+        if (bound >= 0)
+            m_BatchRenderer->EndBatch();
+    }
+    
+    void TestTextureArray::OnImGuiRender()
+    {
+        ImGui::Checkbox("Use texture array", &m_UseArray);
+        ImGui::SameLine();
+        if (ImGui::Button("Shuffle"))
+            ShuffleTiles();
+        
+        const BatchStats& stats = m_BatchRenderer->GetStats();
+        ImGui::Text("%d images (%d layers, at most %d on this driver)", s_ImageCount, m_Array->GetLayerCount(), TextureArray::GetMaxLayers());
+        ImGui::Text("Draw calls: %u for %u quads", stats.DrawCalls, stats.QuadCount);
+        ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    }
+
+}
@@ -0,0 +1,61 @@
+//
+//  TestTextureArray.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TestTextureArray_hpp
+#define TestTextureArray_hpp
+
+#include "Test.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "BatchRenderer.hpp"
+#include "CameraBuffer.hpp"
+#include "Texture.hpp"
+#include "TextureArray.hpp"
+
+namespace test {
+    
+    //A tile map where neighbouring tiles use different images, drawn two ways:
+    //  - One Texture per tile image, the batch has to end every time the next tile needs a different texture
+    //  - Every image as a layer of one TextureArray, the whole map is one batch
+    class TestTextureArray: public Test
+    {
+    public:
+        TestTextureArray();
+        ~TestTextureArray();
+        
+        void OnUpdate(float deltaTime) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+    private:
+        //Picks a new random image for every tile
+        void ShuffleTiles();
+        
+        std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        //basic.shader built with TEXTURE_ARRAY, and without for the separate textures
+        std::unique_ptr<Shader> m_ArrayShader;
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<CameraBuffer> m_Camera;
+        std::unique_ptr<TextureArray> m_Array;
+        std::vector<std::unique_ptr<Texture>> m_Textures;
+        
+        //Image (layer) of each tile, row by row from the bottom left
+        std::vector<unsigned int> m_Tiles;
+        int m_Columns, m_Rows;
+        bool m_UseArray;
+        unsigned int m_Seed;
+    };
+
+}
+
+#endif /* TestTextureArray_hpp */
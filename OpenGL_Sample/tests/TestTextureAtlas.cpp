@@ -0,0 +1,118 @@
+//
+//  TestTextureAtlas.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TestTextureAtlas.hpp"
+
+#include <cmath>
+
+namespace test {
+
+    TestTextureAtlas::TestTextureAtlas()
+        : m_Seed(1)
+    {
+        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        GLCall(glEnable(GL_BLEND));
+        
+        m_BatchRenderer = std::make_unique<BatchRenderer>();
+        
+        m_Shader = std::make_unique<Shader>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/basic.shader");
+        m_Shader->Bind();
+        m_Shader->SetUniform1i("u_Texture", 0);
+        //Vertices are already in world space
+        m_Shader->SetUniformMat4f("u_Model", glm::mat4(1.0f));
+        
+        m_Camera = std::make_unique<CameraBuffer>();
+        
+        m_Atlas = std::make_unique<TextureAtlas>();
+        int bananas = m_Atlas->Add("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.png");
+        if (bananas >= 0)
+            m_Sprites.push_back(bananas);
+        AddSprites(64);
+    }
+
+    TestTextureAtlas::~TestTextureAtlas()
+    {
+    }
+
+    void TestTextureAtlas::AddSprites(int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            //Cheap LCG, only needs to look random
+            m_Seed = m_Seed * 1664525u + 1013904223u;
+            int width = 16 + (m_Seed >> 8) % 240;
+            int height = 16 + (m_Seed >> 16) % 240;
+            unsigned char r = (unsigned char)(m_Seed >> 4), g = (unsigned char)(m_Seed >> 12), b = (unsigned char)(m_Seed >> 20);
+            
+            //Solid color with a checker pattern so each image is easy to tell apart
+            std::vector<unsigned char> pixels(width * height * 4);
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    bool checker = ((x / 8) + (y / 8)) % 2 == 0;
+                    unsigned char* pixel = &pixels[(y * width + x) * 4];
+                    pixel[0] = checker ? r : r / 2;
+                    pixel[1] = checker ? g : g / 2;
+                    pixel[2] = checker ? b : b / 2;
+                    pixel[3] = 255;
+                }
+            }
+            int id = m_Atlas->Add(width, height, pixels.data());
+            if (id >= 0)
+                m_Sprites.push_back(id);
+        }
+    }
+
+    void TestTextureAtlas::OnUpdate(float deltaTime)
+    {
+    }
+
+    void TestTextureAtlas::OnRender()
+    {
+        GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        
+        m_BatchRenderer->BeginFrame();
+        m_Camera->Set(m_View, m_Proj);
+        
+        int columns = (int)std::ceil(std::sqrt((float)m_Sprites.size()));
+        float cellWidth = 960.0f / columns;
+        float cellHeight = 540.0f / columns;
+        
+        //One batch per page, images from different files still end up in the same draw call
+        for (unsigned int page = 0; page < m_Atlas->GetPageCount(); page++)
+        {
+            m_Atlas->GetPage(page).Bind();
+            m_BatchRenderer->BeginBatch(*m_Shader);
+            for (unsigned int i = 0; i < m_Sprites.size(); i++)
+            {
+                const AtlasRegion& region = m_Atlas->GetRegion(m_Sprites[i]);
+                if (region.Page != page)
+                    continue;
+                glm::vec3 position((i % columns + 0.5f) * cellWidth, (i / columns + 0.5f) * cellHeight, 0.0f);
+                m_BatchRenderer->SubmitQuad(position, glm::vec2(cellWidth * 0.9f, cellHeight * 0.9f), region.UVMin, region.UVMax);
+            }
+            m_BatchRenderer->EndBatch();
+        }
+    }
+
+    void TestTextureAtlas::OnImGuiRender()
+    {
+        if (ImGui::Button("Add 16 images"))
+            AddSprites(16);
+        ImGui::SameLine();
+        if (ImGui::Button("Repack"))
+            m_Atlas->Repack();
+        
+        const BatchStats& stats = m_BatchRenderer->GetStats();
+        ImGui::Text("Images: %u on %u page(s), repacked %u time(s)", m_Atlas->GetImageCount(), m_Atlas->GetPageCount(), m_Atlas->GetRepackCount());
+        ImGui::Text("Draw calls: %u for %u quads", stats.DrawCalls, stats.QuadCount);
+        ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    }
+
+}
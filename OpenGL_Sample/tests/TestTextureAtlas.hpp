@@ -0,0 +1,54 @@
+//
+//  TestTextureAtlas.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TestTextureAtlas_hpp
+#define TestTextureAtlas_hpp
+
+#include "Test.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "BatchRenderer.hpp"
+#include "CameraBuffer.hpp"
+#include "TextureAtlas.hpp"
+
+namespace test {
+
+    //Lots of different images drawn with one texture bind and one draw call per atlas page
+    class TestTextureAtlas: public Test
+    {
+    public:
+        TestTextureAtlas();
+        ~TestTextureAtlas();
+        
+        void OnUpdate(float deltaTime) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+    private:
+        //Adds count generated images of random sizes and colors
+        void AddSprites(int count);
+        
+        std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<CameraBuffer> m_Camera;
+        std::unique_ptr<TextureAtlas> m_Atlas;
+        std::vector<int> m_Sprites;
+        
+        glm::mat4 m_Proj = glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f);
+        glm::mat4 m_View = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
+        unsigned int m_Seed;
+    };
+
+}
+
+#endif /* TestTextureAtlas_hpp */
@@ -0,0 +1,125 @@
+//
+//  TestTextureResidency.cpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#include "TestTextureResidency.hpp"
+#include "TextureResidency.hpp"
+
+namespace test {
+    
+    //1 MB each as RGBA8
+    static const int s_GeneratedSize = 512;
+    static const int s_GeneratedCount = 24;
+    
+    //Checkerboard with a different colour and cell size for each, so it's obvious if the wrong one comes back
+    static std::vector<unsigned char> GeneratePixels(int index)
+    {
+        std::vector<unsigned char> pixels(s_GeneratedSize * s_GeneratedSize * 4);
+        unsigned char r = (unsigned char)(80 + (index * 67) % 176);
+        unsigned char g = (unsigned char)(80 + (index * 131) % 176);
+        unsigned char b = (unsigned char)(80 + (index * 29) % 176);
+        int cell = 16 + (index % 4) * 16;
+        for (int y = 0; y < s_GeneratedSize; y++)
+        {
+            for (int x = 0; x < s_GeneratedSize; x++)
+            {
+                unsigned char* pixel = &pixels[(y * s_GeneratedSize + x) * 4];
+                bool dark = ((x / cell) + (y / cell)) % 2 == 0;
+                pixel[0] = dark ? r / 3 : r;
+                pixel[1] = dark ? g / 3 : g;
+                pixel[2] = dark ? b / 3 : b;
+                pixel[3] = 255;
+            }
+        }
+        return pixels;
+    }
+    
+    TestTextureResidency::TestTextureResidency()
+        : m_PreviousBudget(TextureResidency::GetBudget()), m_BudgetMB(8), m_Visible(4), m_First(0), m_SecondsPerStep(0.5f), m_Timer(0.0f)
+    {
+        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        GLCall(glEnable(GL_BLEND));
+        
+        m_BatchRenderer = std::make_unique<BatchRenderer>();
+        
+        m_Shader = std::make_unique<Shader>("/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/shaders/basic.shader");
+        m_Shader->Bind();
+        m_Shader->SetUniform1i("u_Texture", 0);
+        m_Shader->SetUniformMat4f("u_Model", glm::mat4(1.0f));
+        
+        m_Camera = std::make_unique<CameraBuffer>();
+        m_Camera->Set(glm::mat4(1.0f), glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f));
+        
+        //Not through the TextureCache, each file needs its own Texture so there's enough of them to go over budget
+        //Mipmaps so the file ones are a bit bigger than the raw image
+        TextureOptions options;
+        options.Mipmaps = MipmapMode::GPU;
+        const char* files[] =
+        {
+            "/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.png",
+            "/Users/michaeldigregorio/devspace/OpenGL_Sample/OpenGL_Sample/res/textures/bananas.ktx2",
+        };
+        for (int i = 0; i < s_GeneratedCount; i++)
+        {
+            std::vector<unsigned char> pixels = GeneratePixels(i);
+            m_Textures.push_back(std::make_unique<Texture>(s_GeneratedSize, s_GeneratedSize, pixels.data()));
+            //One file texture after every three generated ones
+            if (i % 3 == 2)
+                m_Textures.push_back(std::make_unique<Texture>(files[(i / 3) % 2], options));
+        }
+        
+        TextureResidency::SetBudget((unsigned long long)m_BudgetMB * 1024 * 1024);
+    }
+    
+    TestTextureResidency::~TestTextureResidency()
+    {
+        TextureResidency::SetBudget(m_PreviousBudget);
+    }
+    
+    void TestTextureResidency::OnUpdate(float deltaTime)
+    {
+        m_Timer += deltaTime;
+        if (m_Timer < m_SecondsPerStep)
+            return;
+        m_Timer = 0.0f;
+        m_First = (m_First + 1) % m_Textures.size();
+    }
+    
+    void TestTextureResidency::OnRender()
+    {
+        GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+        GLCall(glClear(GL_COLOR_BUFFER_BIT));
+        
+        m_BatchRenderer->BeginFrame();
+        
+        //A row of squares, one batch each since they all use slot 0
+        float size = 960.0f / m_Visible - 10.0f;
+        for (int i = 0; i < m_Visible; i++)
+        {
+            m_Textures[(m_First + i) % m_Textures.size()]->Bind();
+            m_BatchRenderer->BeginBatch(*m_Shader);
+            m_BatchRenderer->SubmitQuad(glm::vec3(960.0f / m_Visible * (i + 0.5f), 270.0f, 0.0f), glm::vec2(size, size));
+            m_BatchRenderer->EndBatch();
+        }
+    }
+    
+    void TestTextureResidency::OnImGuiRender()
+    {
+        if (ImGui::SliderInt("Budget (MB)", &m_BudgetMB, 0, 64))
+            TextureResidency::SetBudget((unsigned long long)m_BudgetMB * 1024 * 1024);
+        ImGui::SliderInt("Visible", &m_Visible, 1, 8);
+        ImGui::SliderFloat("Seconds per step", &m_SecondsPerStep, 0.0f, 2.0f);
+        
+        unsigned int resident = 0;
+        for (const std::unique_ptr<Texture>& texture : m_Textures)
+            resident += texture->IsResident() ? 1 : 0;
+        const TextureResidencyStats& stats = TextureResidency::GetStats();
+        ImGui::Text("%u of %u textures resident, %.1f MB", resident, (unsigned int)m_Textures.size(), TextureResidency::GetResidentBytes() / (1024.0f * 1024.0f));
+        ImGui::Text("Evictions: %u, restores: %u (%.1f ms)", stats.Evictions, stats.Restores, stats.RestoreMs);
+        ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    }
+
+}
@@ -0,0 +1,57 @@
+//
+//  TestTextureResidency.hpp
+//  OpenGL_Sample
+//
+//  Created by Michael DiGregorio on 10/18/26.
+//
+
+#ifndef TestTextureResidency_hpp
+#define TestTextureResidency_hpp
+
+#include "Test.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "Renderer.h"
+#include "imgui/imgui.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "BatchRenderer.hpp"
+#include "CameraBuffer.hpp"
+#include "Texture.hpp"
+
+namespace test {
+    
+    //Far more textures than the budget allows, only a few of them drawn at a time
+    //The ones drawn move along every so often, so the rest go idle and get evicted and come back when it's their turn again
+    //Half are generated (copied back to the CPU when evicted), half come from files (read from disk again)
+    class TestTextureResidency: public Test
+    {
+    public:
+        TestTextureResidency();
+        ~TestTextureResidency();
+        
+        void OnUpdate(float deltaTime) override;
+        void OnRender() override;
+        void OnImGuiRender() override;
+    private:
+        std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        std::unique_ptr<Shader> m_Shader;
+        std::unique_ptr<CameraBuffer> m_Camera;
+        std::vector<std::unique_ptr<Texture>> m_Textures;
+        
+        //Put back when the test closes
+        unsigned long long m_PreviousBudget;
+        int m_BudgetMB;
+        //How many textures are drawn at once, starting from m_First
+        int m_Visible;
+        unsigned int m_First;
+        float m_SecondsPerStep;
+        float m_Timer;
+    };
+
+}
+
+#endif /* TestTextureResidency_hpp */